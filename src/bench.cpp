@@ -0,0 +1,356 @@
+// bench.cpp
+//
+// Headless benchmark for the wheel. Builds main.cpp into this translation
+// unit (without its main()), renders frames into an offscreen software
+// renderer and feeds a synthetic !join firehose through handle_irc_line
+// from a second thread, the same path real chat takes.
+//
+// Reports frames/s, frame-time percentiles, the profiler's per-stage
+// averages, join latency (handle_irc_line -> on the wheel) and heap
+// allocations per frame.
+//
+// Build with the same libraries as main.cpp, e.g.
+//   g++ -std=c++17 -O2 src/bench.cpp -lSDL3 -lSDL3_ttf -lSDL3_image -pthread -o wheel_bench
+//   cl /std:c++17 /O2 /EHsc src\bench.cpp SDL3.lib SDL3_ttf.lib SDL3_image.lib ws2_32.lib
+// and run it from the repo root so assets/ resolves:
+//   wheel_bench --entries 1000 --frames 600 --join-rate 2000 --names mixed
+
+#ifdef __EMSCRIPTEN__
+#error "bench.cpp is a native-only tool"
+#endif
+
+#define SDL_MAIN_HANDLED
+#define SHOEPEWHEEL_NO_MAIN
+#include "main.cpp"
+
+#include <cstdlib>
+
+
+// ----------------------
+// Options
+// ----------------------
+
+struct BenchOptions {
+    int         entries = 1000;     // prefilled before the first frame
+    int         frames = 600;
+    int         joins = 5000;       // firehose total (0 = no firehose)
+    int         join_rate = 2000;   // firehose joins per second
+    int         noise = 1;          // non-!join chat lines per join
+    int         width = 940;
+    int         height = 720;
+    int         sprites = 6;        // background wakas
+    bool        spin = false;       // keep the wheel spinning
+    bool        workers = true;     // geometry worker pool (--no-workers = render thread only)
+    bool        verbose = false;    // let [Twitch]/[Wheel] info logs through
+    std::string names = "mixed";    // short | mixed | long
+    uint32_t    seed = 1;
+};
+
+static void print_usage() {
+    std::printf(
+        "usage: wheel_bench [options]\n"
+        "  --entries N      names on the wheel before the first frame (default 1000)\n"
+        "  --frames N       frames to render (default 600)\n"
+        "  --joins N        synthetic !joins to send, 0 disables (default 5000)\n"
+        "  --join-rate N    !joins per second (default 2000)\n"
+        "  --noise N        ordinary chat lines per !join (default 1)\n"
+        "  --names KIND     name lengths: short (4-8), mixed (4-25), long (18-25)\n"
+        "  --size WxH       render size (default 940x720)\n"
+        "  --sprites N      background waka count (default 6)\n"
+        "  --spin           keep the wheel spinning the whole run\n"
+        "  --no-workers     build wheel geometry on the render thread only\n"
+        "  --seed N         name generator seed (default 1)\n"
+        "  --verbose        show info-level logs\n");
+}
+
+static bool parse_options(int argc, char** argv, BenchOptions& o) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "%s needs a value\n", name);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        const char* v = nullptr;
+        if (arg == "--entries" && (v = next("--entries"))) o.entries = std::atoi(v);
+        else if (arg == "--frames" && (v = next("--frames"))) o.frames = std::atoi(v);
+        else if (arg == "--joins" && (v = next("--joins"))) o.joins = std::atoi(v);
+        else if (arg == "--join-rate" && (v = next("--join-rate"))) o.join_rate = std::atoi(v);
+        else if (arg == "--noise" && (v = next("--noise"))) o.noise = std::atoi(v);
+        else if (arg == "--names" && (v = next("--names"))) o.names = v;
+        else if (arg == "--sprites" && (v = next("--sprites"))) o.sprites = std::atoi(v);
+        else if (arg == "--seed" && (v = next("--seed"))) o.seed = static_cast<uint32_t>(std::strtoul(v, nullptr, 10));
+        else if (arg == "--size" && (v = next("--size"))) {
+            if (std::sscanf(v, "%dx%d", &o.width, &o.height) != 2) return false;
+        }
+        else if (arg == "--spin") o.spin = true;
+        else if (arg == "--no-workers") o.workers = false;
+        else if (arg == "--verbose") o.verbose = true;
+        else {
+            return false;
+        }
+    }
+    return o.entries >= 0 && o.frames > 0 && o.joins >= 0 && o.join_rate > 0 &&
+        o.noise >= 0 && o.sprites >= 0 && o.sprites <= MAX_BACKGROUND_SPRITES && o.width > 0 && o.height > 0 &&
+        (o.names == "short" || o.names == "mixed" || o.names == "long");
+}
+
+
+// ----------------------
+// Synthetic names and chat
+// ----------------------
+
+// "<letters>_<seq>" with a total length drawn from the chosen distribution.
+// The numeric suffix keeps names unique and lets the latency check map an
+// entry back to the moment its !join was sent.
+static std::string make_name(std::mt19937& rng, const std::string& kind, uint32_t seq) {
+    static const char ALPHABET[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    int lo = 4, hi = 25;
+    if (kind == "short") { lo = 4;  hi = 8; }
+    if (kind == "long")  { lo = 18; hi = 25; }
+
+    std::string suffix = "_" + std::to_string(seq);
+    int len = std::uniform_int_distribution<int>(lo, hi)(rng);
+    int letters = std::max(1, len - static_cast<int>(suffix.size()));
+
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(sizeof(ALPHABET) - 2));
+    std::string name;
+    name.reserve(static_cast<size_t>(letters) + suffix.size());
+    for (int i = 0; i < letters; ++i) name += ALPHABET[pick(rng)];
+    return name + suffix;
+}
+
+static uint32_t name_seq(std::string_view name) {
+    size_t us = name.rfind('_');
+    if (us == std::string_view::npos) return UINT32_MAX;
+    uint32_t seq = 0;
+    for (size_t i = us + 1; i < name.size(); ++i) {
+        if (name[i] < '0' || name[i] > '9') return UINT32_MAX;
+        seq = seq * 10 + static_cast<uint32_t>(name[i] - '0');
+    }
+    return seq;
+}
+
+// Firehose state shared with the main thread. sent_ns[seq] is written
+// before the join is pushed onto command_queue, and read only after the main
+// loop has drained that join, so the queue's release/acquire orders it.
+struct Firehose {
+    std::vector<std::string> names;
+    std::vector<Uint64>      sent_ns;
+    std::atomic<bool>        running{ true };
+    std::atomic<int>         sent{ 0 };
+};
+
+static void firehose_thread(Firehose& fh, int rate, int noise) {
+    const Uint64 start = SDL_GetTicksNS();
+    const int total = static_cast<int>(fh.names.size());
+    std::string line;
+    int sent = 0;
+
+    while (fh.running.load(std::memory_order_relaxed) && sent < total) {
+        double elapsed = static_cast<double>(SDL_GetTicksNS() - start) / 1e9;
+        int due = std::min(total, static_cast<int>(elapsed * rate) + 1);
+
+        for (; sent < due; ++sent) {
+            const std::string& nick = fh.names[static_cast<size_t>(sent)];
+            for (int k = 0; k < noise; ++k) {
+                line = ":" + nick + "!" + nick + "@" + nick +
+                    ".tmi.twitch.tv PRIVMSG #bench :PogChamp hype in the chat";
+                handle_irc_line(line, INVALID_SOCKET, app);
+            }
+            line = "@badge-info=;color=#1E90FF;display-name=" + nick +
+                " :" + nick + "!" + nick + "@" + nick +
+                ".tmi.twitch.tv PRIVMSG #bench :!join";
+            fh.sent_ns[static_cast<size_t>(sent)] = SDL_GetTicksNS();
+            handle_irc_line(line, INVALID_SOCKET, app);
+        }
+        fh.sent.store(sent, std::memory_order_relaxed);
+        SDL_DelayNS(500000); // 0.5 ms
+    }
+}
+
+
+// ----------------------
+// Reporting
+// ----------------------
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    size_t k = std::min(v.size() - 1, static_cast<size_t>(p * static_cast<double>(v.size())));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+static double mean(const std::vector<double>& v) {
+    if (v.empty()) return 0.0;
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return sum / static_cast<double>(v.size());
+}
+
+
+// ----------------------
+// Main
+// ----------------------
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!parse_options(argc, argv, opt)) {
+        print_usage();
+        return 2;
+    }
+    if (!opt.verbose) {
+        g_log.min_level.store(LogLevel::Warn);
+    }
+
+    install_alloc_counting();
+    if (!SDL_Init(0)) {
+        std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
+        return 1;
+    }
+    if (!TTF_Init()) {
+        std::cerr << "TTF_Init failed: " << SDL_GetError() << "\n";
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Surface* target = SDL_CreateSurface(opt.width, opt.height, SDL_PIXELFORMAT_RGBA8888);
+    app.renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!app.renderer) {
+        std::cerr << "Software renderer failed: " << SDL_GetError() << "\n";
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+    text_engine_open(app.renderer);
+    if (!assets_load_blocking(app)) {
+        SDL_DestroyRenderer(app.renderer);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+    app.background_sprites = opt.sprites;
+    if (opt.workers) {
+        workers_start();
+    }
+
+    log_start();
+
+    // Prefill
+    std::mt19937 rng(opt.seed);
+    uint32_t seq = 0;
+    {
+        std::lock_guard<std::mutex> lock(app.entries_mutex);
+        for (int i = 0; i < opt.entries; ++i) {
+            add_player_locked(app, make_name(rng, opt.names, seq++));
+        }
+    }
+    const size_t prefilled = app.entries.size();
+    const uint32_t firstJoinSeq = seq;
+    init_channel_stats(app, { "#bench" });
+    app.join_open.store(true);
+
+    Firehose fh;
+    for (int i = 0; i < opt.joins; ++i) {
+        fh.names.push_back(make_name(rng, opt.names, seq++));
+    }
+    fh.sent_ns.assign(fh.names.size(), 0);
+
+    std::thread firehose;
+    if (!fh.names.empty()) {
+        firehose = std::thread(firehose_thread, std::ref(fh), opt.join_rate, opt.noise);
+    }
+
+    // Run
+    const TwitchConfig cfg;
+    const float dt = 1.0f / 60.0f;
+    std::vector<double> frameMs, frameAllocs, joinLatencyMs;
+    frameMs.reserve(static_cast<size_t>(opt.frames));
+    frameAllocs.reserve(static_cast<size_t>(opt.frames));
+    joinLatencyMs.reserve(fh.names.size());
+    size_t seen = prefilled;
+
+    const Uint64 runStart = SDL_GetTicksNS();
+    for (int f = 0; f < opt.frames; ++f) {
+        if (opt.spin && !app.spinning) {
+            std::lock_guard<std::mutex> lock(app.entries_mutex);
+            app.celebration_active = false;
+            app.celebration_name.clear();
+            if (app.entries.size() >= 2) {
+                start_spin_locked(app);
+            }
+        }
+
+        Uint64 t0 = SDL_GetTicksNS();
+        frame(cfg, dt);  // counts its own heap allocations into t_alloc_count
+        Uint64 t1 = SDL_GetTicksNS();
+
+        frameMs.push_back(static_cast<double>(t1 - t0) / 1e6);
+        frameAllocs.push_back(static_cast<double>(t_alloc_count));
+
+        // Entries are only appended by this thread (dispatch_chat_commands), so
+        // anything past `seen` arrived during this frame.
+        for (; seen < app.entries.size(); ++seen) {
+            uint32_t s = name_seq(app.entries.name(seen));
+            if (s >= firstJoinSeq && s - firstJoinSeq < fh.sent_ns.size()) {
+                joinLatencyMs.push_back(
+                    static_cast<double>(t1 - fh.sent_ns[s - firstJoinSeq]) / 1e6);
+            }
+        }
+    }
+    const double wallSec = static_cast<double>(SDL_GetTicksNS() - runStart) / 1e9;
+
+    fh.running.store(false);
+    if (firehose.joinable()) firehose.join();
+
+    // Report
+    std::printf("entries          %zu prefilled, %zu at end (%s names, %dx%d%s)\n",
+        prefilled, app.entries.size(), opt.names.c_str(), opt.width, opt.height,
+        opt.spin ? ", spinning" : "");
+    std::printf("frames           %d in %.2f s = %.1f fps\n",
+        opt.frames, wallSec, opt.frames / wallSec);
+    std::printf("frame ms         avg %.3f  p50 %.3f  p99 %.3f  max %.3f\n",
+        mean(frameMs), percentile(frameMs, 0.50), percentile(frameMs, 0.99),
+        percentile(frameMs, 1.0));
+    std::printf("allocs / frame   avg %.1f  p99 %.0f  max %.0f\n",
+        mean(frameAllocs), percentile(frameAllocs, 0.99), percentile(frameAllocs, 1.0));
+    std::printf("joins            %d sent, %zu on the wheel\n",
+        fh.sent.load(), joinLatencyMs.size());
+    if (!joinLatencyMs.empty()) {
+        std::printf("join latency ms  avg %.3f  p50 %.3f  p99 %.3f  max %.3f\n",
+            mean(joinLatencyMs), percentile(joinLatencyMs, 0.50),
+            percentile(joinLatencyMs, 0.99), percentile(joinLatencyMs, 1.0));
+    }
+
+    std::printf("\nlast %d frames (profiler)   min      avg      p99  ms\n", g_prof.filled);
+    for (int s = 0; s < PROF_STAGE_COUNT; ++s) {
+        ProfStats st = prof_stats(g_prof.stage_ms[s], g_prof.filled);
+        std::printf("  %-24s %7.3f  %7.3f  %7.3f\n", PROF_STAGE_NAMES[s], st.min, st.avg, st.p99);
+    }
+    for (int c = 0; c < PROF_COUNTER_COUNT; ++c) {
+        uint64_t sum = 0;
+        for (int i = 0; i < g_prof.filled; ++i) sum += g_prof.counter_hist[c][i];
+        std::printf("  %-24s avg %.1f / frame\n", PROF_COUNTER_NAMES[c],
+            g_prof.filled ? static_cast<double>(sum) / g_prof.filled : 0.0);
+    }
+
+    log_stop();
+
+    workers_stop();
+    label_cache_clear();
+    text_engine_close();
+    text_widget_release(g_status_text);
+    text_widget_release(g_hold_text);
+    text_widget_release(g_search_text);
+    if (app.waka_texture) SDL_DestroyTexture(app.waka_texture);
+    SDL_DestroyRenderer(app.renderer);
+    SDL_DestroySurface(target);
+    assets_release(app);
+    TTF_Quit();
+    SDL_Quit();
+    return 0;
+}
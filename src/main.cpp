@@ -1,22 +1,33 @@
 // main.cpp
 //
-// SDL3 "Wheel of Names" with Twitch chat integration (Windows-only sample)
+// SDL3 "Wheel of Names" with Twitch chat integration (Windows / POSIX / web)
 //
 // Requirements:
 //  - SDL3 and SDL3_ttf development libraries
 //  - A TTF font file in the working directory (see FONT_PATH below)
 //  - A Twitch account + chat OAuth token (see TWITCH_* constants)
 //  - Windows toolchain (MSVC / MinGW) and linking to SDL3, SDL3_ttf, ws2_32
+//    (or any POSIX toolchain; BSD sockets need no extra library)
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten/emscripten.h>
 // NO winsock on the web
-#else
+#elif defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #pragma comment(lib, "ws2_32.lib")
+#else
+// BSD sockets for non-Windows desktop builds
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
 #endif
 
 // SDL includes: SDL3 everywhere (Windows + Web)
@@ -29,15 +40,26 @@
 #include <sstream>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cmath>
+#include <cstdarg>
+#include <cstdio>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <random>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
 
 // ----------------------
 // Configuration
@@ -47,6 +69,14 @@
 // Adjust this if needed.
 static const char* FONT_PATH = "assets/fonts/WheelLabel.ttf";
 static const char* LIST_FONT_PATH = "assets/fonts/ListLabel.otf";
+static const char* WAKA_PATH = "assets/images/waka.png";
+// Optional font for glyphs the two above lack (CJK, Hangul, emoji, ...),
+// e.g. a Noto Sans CJK build. Attached to every font as a fallback.
+static const char* FALLBACK_FONT_PATH = "assets/fonts/Fallback.ttf";
+
+static constexpr float WHEEL_FONT_SIZE = 34.0f;
+static constexpr float STATUS_FONT_SIZE = 26.0f;
+static constexpr float LIST_FONT_SIZE = 15.0f;
 
 static constexpr float NAME_PANEL_WIDTH_FRAC = 0.28f; // 28% of window width
 
@@ -56,14 +86,193 @@ static constexpr float WAKA_PIVOT_Y = 0.55f;
 
 static constexpr float CONTENT_Y_OFFSET = 25.0f; // vertical offset for wheel + name list
 
+static constexpr int MAX_BACKGROUND_SPRITES = 256; // cap for "background_sprites=" in twitch.cfg
+static constexpr int MAX_ENTRY_TICKETS = 100;      // cap for "sub_tickets=" / "max_tickets="
+static constexpr int MAX_COMMAND_LIMIT = 1000000;  // cap for the chat command limits in twitch.cfg
+
 
 // ----------------------
 // Types
 // ----------------------
 
-struct WheelEntry {
-    std::string name;
-    SDL_Color   color;
+// Wheel entries as parallel arrays: slice colors in one contiguous array and
+// every name interned back to back in a single arena string. Draw loops only
+// stream through the array they need, and copying the store is a few flat
+// copies instead of one heap allocation per name.
+//
+// Each entry holds some tickets (its weight), and its slice is its share of
+// the total. A Fenwick tree over the weights gives prefix sums and the
+// ticket -> entry lookup in O(log n); appends and weight bumps update it in
+// O(log n) too, so a join never rebuilds it.
+struct EntryStore {
+    std::vector<SDL_Color> colors;
+    std::vector<uint32_t>  name_offsets; // into names
+    std::vector<uint32_t>  name_lengths;
+    std::vector<uint32_t>  weights;      // tickets per entry, >= 1
+    std::vector<uint64_t>  tree = std::vector<uint64_t>(1, 0); // Fenwick, 1-based
+    std::string            names;        // arena
+    uint64_t               total_weight = 0;
+    uint32_t               max_weight = 0;
+
+    size_t size() const { return colors.size(); }
+    bool empty() const { return colors.empty(); }
+
+    std::string_view name(size_t i) const {
+        return std::string_view(names.data() + name_offsets[i], name_lengths[i]);
+    }
+
+    void push_back(std::string_view name, SDL_Color color, uint32_t weight = 1) {
+        weight = std::max<uint32_t>(weight, 1);
+        colors.push_back(color);
+        name_offsets.push_back(static_cast<uint32_t>(names.size()));
+        name_lengths.push_back(static_cast<uint32_t>(name.size()));
+        names.append(name.data(), name.size());
+        weights.push_back(weight);
+
+        // New node k covers (k - lowbit(k), k]; everything before it is built
+        size_t k = weights.size();
+        tree.push_back(weight + prefix_weight(k - 1) - prefix_weight(k - (k & (~k + 1))));
+        total_weight += weight;
+        max_weight = std::max(max_weight, weight);
+    }
+
+    void add_weight(size_t i, uint32_t delta) {
+        weights[i] += delta;
+        total_weight += delta;
+        max_weight = std::max(max_weight, weights[i]);
+        for (size_t k = i + 1; k < tree.size(); k += k & (~k + 1)) {
+            tree[k] += delta;
+        }
+    }
+
+    // Sum of the weights of entries [0, count)
+    uint64_t prefix_weight(size_t count) const {
+        uint64_t sum = 0;
+        for (size_t k = count; k > 0; k &= k - 1) {
+            sum += tree[k];
+        }
+        return sum;
+    }
+
+    // Entry holding ticket t, for t in [0, total_weight)
+    size_t find_ticket(uint64_t t) const {
+        size_t pos = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (pos + step < tree.size() && tree[pos + step] <= t) {
+                pos += step;
+                t -= tree[pos];
+            }
+        }
+        return std::min(pos, size() - 1);
+    }
+
+    void clear() {
+        colors.clear();
+        name_offsets.clear();
+        name_lengths.clear();
+        weights.clear();
+        tree.assign(1, 0);
+        names.clear();
+        total_weight = 0;
+        max_weight = 0;
+    }
+};
+
+// Bounded lock-free multi-producer / single-consumer queue (a Vyukov-style
+// ring of sequence-numbered cells). push() never blocks: it returns false
+// when the ring is full. pop() must only be called from one thread.
+template <typename T, size_t Capacity>
+struct MpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "MpscRing capacity must be a power of two");
+
+    MpscRing() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(T&& value) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & (Capacity - 1)];
+            size_t seq = cell.seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                return false; // full
+            }
+            else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer only: true if pop() would return an element right now
+    bool ready() const {
+        const Cell& cell = cells[head & (Capacity - 1)];
+        return cell.seq.load(std::memory_order_acquire) == head + 1;
+    }
+
+    bool pop(T& out) {
+        Cell& cell = cells[head & (Capacity - 1)];
+        size_t seq = cell.seq.load(std::memory_order_acquire);
+        if (seq != head + 1) {
+            return false; // empty (or the producer hasn't finished writing)
+        }
+        out = std::move(cell.value);
+        cell.seq.store(head + Capacity, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq{ 0 };
+        T value{};
+    };
+
+    Cell cells[Capacity];
+    alignas(64) std::atomic<size_t> tail{ 0 }; // producers
+    alignas(64) size_t head = 0;               // consumer only
+};
+
+// Chat commands the main loop acts on (see "Chat commands")
+enum class CommandKind : uint8_t { Join, Spin, Reset };
+static constexpr int COMMAND_KIND_COUNT = 3;
+
+// ChatCommand::channel for a sender outside channel_stats (an unlisted
+// PRIVMSG target, or the web page); such commands aren't counted.
+static constexpr uint8_t NO_CHANNEL = 0xFF;
+
+// A command seen in chat, waiting for the main loop to apply it
+struct ChatCommand {
+    CommandKind kind = CommandKind::Join;
+    std::string name;         // sender; may be empty for commands from the page
+    uint8_t     channel = NO_CHANNEL; // index into AppState::channel_stats
+    bool        subscriber = false;
+};
+
+static constexpr size_t COMMAND_QUEUE_CAPACITY = 4096;
+
+// Twitch lets a normal account JOIN 20 channels per 10 seconds; we send
+// every JOIN at login, so more than that would get the session dropped.
+static constexpr size_t MAX_TWITCH_CHANNELS = 20;
+
+// Per-channel !join counters, so a co-stream can see where joins come from.
+// The list is fixed before the chat thread starts; only the counters move.
+struct ChannelStats {
+    std::string           name;        // "#channel", lowercase
+    std::atomic<uint32_t> joins{ 0 };  // !join lines seen (chat thread)
+    std::atomic<uint32_t> added{ 0 };  // of those, new players (main loop)
 };
 
 struct AppState {
@@ -76,8 +285,20 @@ struct AppState {
     int waka_w = 0;
     int waka_h = 0;
 
-    std::vector<WheelEntry> entries;
-    std::mutex              entries_mutex;                 
+    EntryStore              entries;
+    std::unordered_map<std::string, uint32_t> entry_keys;  // fold_case(name) -> index in entries
+    std::mutex              entries_mutex;                 // guards entries + entry_keys
+    std::atomic<uint64_t>   entries_version{ 0 };          // bumped on every join / reset
+
+    // Immutable copy of entries the renderer draws from. Only replaced
+    // (on the render thread) when entries_version moves.
+    std::shared_ptr<const EntryStore> entries_snapshot;
+    uint64_t                snapshot_version = ~0ull;
+
+    // Chat thread (or page) -> main loop. Drained once per frame in frame().
+    MpscRing<ChatCommand, COMMAND_QUEUE_CAPACITY> command_queue;
+    std::atomic<uint32_t>   command_queue_dropped{ 0 };
+    std::vector<ChannelStats> channel_stats;               // same order as TwitchConfig::channels
 
     float current_angle = 0.0f;      // radians
     float angular_velocity = 0.0f;   // radians/sec
@@ -96,12 +317,46 @@ struct AppState {
     float celebration_time = 0.0f;
     std::string celebration_name;
     SDL_Color celebration_color{ 255, 255, 255, 255 };
-    float spin_friction = 3.0f;
+    float spin_friction = 3.0f;      // deceleration, radians/sec^2
+
+    // Closed-form spin, solved once in start_spin_locked():
+    //   angle(t) = start + v0*t - friction*t^2/2, stopping at t = v0/friction.
+    // frame() only advances spin_time, so frame timing can't move the result.
+    float    spin_time = 0.0f;          // seconds since the spin started
+    float    spin_duration = 0.0f;
+    float    spin_start_angle = 0.0f;
+    float    spin_initial_velocity = 0.0f;
+    float    spin_final_angle = 0.0f;   // wrapped to [0, 2pi)
+    int      spin_winner = -1;          // pointer slice at spin_final_angle
+    uint64_t spin_entries_version = 0;  // entries the winner was computed for
+    uint64_t spin_seed = 0;             // launch speed / friction derive from this
+    uint64_t spin_entries_hash = 0;     // entries_hash() at spin start
+    size_t   spin_entry_count = 0;      // entries.size() at spin start
+    bool     seeded_spins = false;      // "spin_seed=" set: seeds follow from it
+    uint64_t spin_seed_state = 0;       // splitmix64 state for seeded_spins
     bool  reset_hold_active = false;  // true while user is holding to reset
     float reset_hold_elapsed = 0.0f;  // seconds since hold began
     int   reset_hold_source = 0;      // 0 = none, 1 = space, 2 = mouse
     bool  authorized = false;
     std::atomic<bool> join_open{ false };
+
+    // --- Frame pacing (see "Frame pacing") ---
+    bool     background_animation = true;    // drift / rotate the background wakas
+    int      background_sprites = 6;         // background waka count, from twitch.cfg
+
+    // --- Tickets (slice weights) ---
+    uint32_t sub_tickets = 2;  // a subscriber's first !join
+    uint32_t max_tickets = 3;  // repeated !joins add one ticket up to this
+
+    // --- Chat command limits (see "Chat commands") ---
+    uint32_t command_window_ms = 2000;     // same command from the same user is dropped inside this
+    uint32_t user_commands_per_min = 12;   // per-user refill, bursts of USER_COMMAND_BURST; 0 = off
+    uint32_t commands_per_sec = 2000;      // all users together; 0 = no global limit
+    bool     redraw_requested = true;        // input or a state change since the last draw
+    bool     last_frame_animating = false;
+    uint64_t drawn_entries_version = ~0ull;
+    std::atomic<bool> idle_waiting{ false }; // main loop is parked in idle_wait()
+
     TTF_Font* timer_font = nullptr;
     TimerState timer;
 };
@@ -110,218 +365,997 @@ AppState app;
 struct TwitchConfig {
     std::string oauth;
     std::string nick;
-    std::string channel;
+    std::string channel;                // host channel (first in the list)
+    std::vector<std::string> channels;  // every channel to JOIN, "#name" lowercase
+    bool animate_background = true;     // "animate_background=0" keeps the wakas still
+    int  background_sprites = 6;        // number of background wakas (0..MAX_BACKGROUND_SPRITES)
+    int  sub_tickets = 2;               // tickets for a subscriber's first !join
+    int  max_tickets = 3;               // repeated !joins add a ticket up to this (1 = off)
+    int  command_window_ms = 2000;      // dedupe window for repeated chat commands
+    int  user_commands_per_min = 12;    // per-user chat command rate (0 = unlimited)
+    int  commands_per_sec = 2000;       // global chat command rate (0 = unlimited)
+    std::string journal = "wheel.journal"; // saved wheel state; "journal=" (empty) turns it off
+    bool     seeded_spins = false;      // "spin_seed=<hex>": reproducible spin seeds
+    uint64_t spin_seed = 0;
 };
 
 TwitchConfig g_twitch_cfg;
 
-static void render_text_bottom_right(SDL_Renderer* renderer,
-    TTF_Font* font,
-    const std::string& text,
-    SDL_Color color,
-    float x,
-    float y)
-{
-    if (!renderer || !font) return;
-    if (text.empty()) return;
-
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), 0, color);
-    if (!surface) {
-        std::cerr << "TTF_RenderText_Blended (bottom-right) failed: "
-                  << SDL_GetError() << "\n";
-        return;
-    }
+// ----------------------
+// Logging
+// ----------------------
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "SDL_CreateTextureFromSurface (bottom-right) failed: "
-                  << SDL_GetError() << "\n";
-        SDL_DestroySurface(surface);
-        return;
-    }
+// Leveled log sink. Callers format into a fixed-size record and push it
+// onto a lock-free ring; a background thread writes batches to the console
+// and flushes once per batch, so a slow (synchronous) Windows console can't
+// stall the chat thread or the renderer. Before log_start() / after
+// log_stop(), and on the web build, records are written synchronously.
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    uint16_t length = 0;
+    char     text[254];
+};
 
-    SDL_FRect dst{};
-    dst.w = static_cast<float>(surface->w);
-    dst.h = static_cast<float>(surface->h);
+static constexpr size_t LOG_QUEUE_CAPACITY = 1024;
 
-    // (x, y) is the bottom-right corner
-    dst.x = x - dst.w;
-    dst.y = y - dst.h;
+struct LogSink {
+    MpscRing<LogRecord, LOG_QUEUE_CAPACITY> queue;
+    std::atomic<uint32_t> dropped{ 0 };
+    std::atomic<bool>     async{ false };    // flush thread is accepting records
+    std::atomic<bool>     running{ false };
+    std::atomic<LogLevel> min_level{ LogLevel::Info };
+    std::thread           thread;
+};
 
-    SDL_DestroySurface(surface);
+LogSink g_log;
 
-    SDL_RenderTexture(renderer, texture, nullptr, &dst);
-    SDL_DestroyTexture(texture);
+static void log_write_record(const LogRecord& rec) {
+    std::ostream& out = (rec.level >= LogLevel::Warn) ? std::cerr : std::cout;
+    out.write(rec.text, rec.length);
+    out.put('\n');
 }
 
+static bool log_enabled(LogLevel level) {
+    return level >= g_log.min_level.load(std::memory_order_relaxed);
+}
 
-static void trim_in_place(std::string& s) {
-    size_t first = s.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) {
-        s.clear();
+#if defined(__GNUC__)
+__attribute__((format(printf, 2, 3)))
+#endif
+static void log_msg(LogLevel level, const char* fmt, ...) {
+    if (!log_enabled(level)) return;
+
+    LogRecord rec;
+    rec.level = level;
+    va_list args;
+    va_start(args, fmt);
+    int n = std::vsnprintf(rec.text, sizeof(rec.text), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    rec.length = static_cast<uint16_t>(std::min<size_t>(static_cast<size_t>(n), sizeof(rec.text) - 1));
+
+    if (!g_log.async.load(std::memory_order_acquire)) {
+        log_write_record(rec);
+        (level >= LogLevel::Warn ? std::cerr : std::cout).flush();
         return;
     }
-    size_t last = s.find_last_not_of(" \t\r\n");
-    s = s.substr(first, last - first + 1);
+    if (!g_log.queue.push(std::move(rec))) {
+        g_log.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-static std::string to_lower(const std::string& s);
-
-static bool load_twitch_config(const char* path, TwitchConfig& out) {
-    std::ifstream in(path);
-    if (!in) {
-        std::cerr << "[Twitch] Could not open config file: " << path << "\n";
-        return false;
+#define log_debug(...) log_msg(LogLevel::Debug, __VA_ARGS__)
+#define log_info(...)  log_msg(LogLevel::Info,  __VA_ARGS__)
+#define log_warn(...)  log_msg(LogLevel::Warn,  __VA_ARGS__)
+#define log_error(...) log_msg(LogLevel::Error, __VA_ARGS__)
+
+// Write everything queued so far. Flush thread (or log_stop) only.
+static void log_drain() {
+    LogRecord rec;
+    bool wrote = false;
+    while (g_log.queue.pop(rec)) {
+        log_write_record(rec);
+        wrote = true;
     }
+    uint32_t dropped = g_log.dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        std::cerr << "[Log] Queue full; dropped " << dropped << " message(s)\n";
+    }
+    if (wrote || dropped > 0) {
+        std::cout.flush();
+        std::cerr.flush();
+    }
+}
 
-    std::string line;
-    while (std::getline(in, line)) {
-        trim_in_place(line);
-        if (line.empty() || line[0] == '#')
-            continue;
-
-        size_t eq = line.find('=');
-        if (eq == std::string::npos)
-            continue;
-
-        std::string key = line.substr(0, eq);
-        std::string value = line.substr(eq + 1);
-        trim_in_place(key);
-        trim_in_place(value);
-
-        std::string lkey = to_lower(key);
-        if (lkey == "oauth") {
-            out.oauth = value;
-        }
-        else if (lkey == "nick") {
-            out.nick = value;
-        }
-        else if (lkey == "channel") {
-            out.channel = value;
+static void log_start() {
+#ifndef __EMSCRIPTEN__
+    if (g_log.running.exchange(true)) return;
+    g_log.thread = std::thread([] {
+        while (g_log.running.load(std::memory_order_relaxed)) {
+            log_drain();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
         }
+    });
+    g_log.async.store(true, std::memory_order_release);
+#endif
+}
+
+// Stop the flush thread and write out anything still queued. Call after
+// every other thread that logs has been joined.
+static void log_stop() {
+#ifndef __EMSCRIPTEN__
+    if (!g_log.running.exchange(false)) return;
+    g_log.async.store(false, std::memory_order_release);
+    if (g_log.thread.joinable()) {
+        g_log.thread.join();
     }
+    log_drain();
+#endif
+}
 
+static bool parse_log_level(const std::string& s, LogLevel& out) {
+    if (s == "debug") out = LogLevel::Debug;
+    else if (s == "info") out = LogLevel::Info;
+    else if (s == "warn" || s == "warning") out = LogLevel::Warn;
+    else if (s == "error") out = LogLevel::Error;
+    else return false;
     return true;
 }
 
-
 // ----------------------
-// Utility: RNG, colors
+// Frame profiler
 // ----------------------
 
-static void draw_filled_triangle(SDL_Renderer* renderer,
-    SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, SDL_Color color);
+// Per-stage frame timings plus a few per-frame counters, kept for the
+// last PROF_HISTORY frames. F3 toggles an overlay with rolling
+// min/avg/p99, F4 dumps the history as CSV. Recording is always on; it
+// costs two performance-counter reads per scope.
+enum ProfStage {
+    PROF_FRAME,        // all of frame(), including present
+    PROF_ENTRIES,      // join drain + entry snapshot
+    PROF_BACKGROUND,
+    PROF_WHEEL,
+    PROF_NAME_LIST,
+    PROF_HUD,          // status pill + hold-to-reset card
+    PROF_BANNER,
+    PROF_PRESENT,
+    PROF_STAGE_COUNT
+};
 
-static void draw_spin_droplet(SDL_Renderer* renderer,
-    float cx, float cy, float r, SDL_Color color);
+enum ProfCounter {
+    PROF_DRAW_CALLS,        // SDL_Render* submissions
+    PROF_TEXTURES_CREATED,
+    PROF_TTF_RENDERS,       // TTF rasterizations
+    PROF_HEAP_ALLOCS,       // operator new + SDL_malloc on the render thread
+    PROF_COUNTER_COUNT
+};
 
+static const char* const PROF_STAGE_NAMES[PROF_STAGE_COUNT] = {
+    "frame", "entries", "background", "wheel", "name_list", "hud", "banner", "present"
+};
+static const char* const PROF_COUNTER_NAMES[PROF_COUNTER_COUNT] = {
+    "draw_calls", "textures_created", "ttf_renders", "heap_allocs"
+};
 
-static std::mt19937& global_rng() {
-    static std::mt19937 rng{ std::random_device{}() };
-    return rng;
+static constexpr int PROF_HISTORY = 300; // ~5 s at 60 fps
+
+struct Profiler {
+    bool     overlay = false;
+    Uint64   stage_ticks[PROF_STAGE_COUNT]{};    // current frame
+    uint32_t counters[PROF_COUNTER_COUNT]{};     // current frame
+
+    float    stage_ms[PROF_STAGE_COUNT][PROF_HISTORY]{};
+    uint32_t counter_hist[PROF_COUNTER_COUNT][PROF_HISTORY]{};
+    int      cursor = 0;   // next history slot
+    int      filled = 0;   // valid history entries
+    uint64_t frames = 0;   // frames recorded in total
+};
+
+Profiler g_prof;
+
+static void prof_count(ProfCounter c, uint32_t n = 1) {
+    g_prof.counters[c] += n;
 }
 
-// Replace the existing random_color() with this version
-static SDL_Color random_color() {
-    static const SDL_Color palette[] = {
-        { 0,   100, 0,   255 },  // dark green
-        { 100, 170, 120, 255 },  // light green
-        { 255, 165, 0,   255 },  // orange
-        { 240, 210, 60,  255  }
-    };
+// Time since `start` (a performance-counter value) goes to `stage`.
+static void prof_add(ProfStage stage, Uint64 start) {
+    g_prof.stage_ticks[stage] += SDL_GetPerformanceCounter() - start;
+}
 
-    static std::atomic<uint32_t> idx{ 0 };
-    uint32_t i = idx.fetch_add(1, std::memory_order_relaxed);
-    return palette[i % (sizeof(palette) / sizeof(palette[0]))];
+// Adds its lifetime to one stage of the current frame.
+struct ProfScope {
+    explicit ProfScope(ProfStage s) : stage(s), start(SDL_GetPerformanceCounter()) {}
+    ~ProfScope() { prof_add(stage, start); }
+    ProfScope(const ProfScope&) = delete;
+    ProfScope& operator=(const ProfScope&) = delete;
+
+    ProfStage stage;
+    Uint64    start;
+};
+
+// Heap allocations are counted only on a thread that opted in, so the chat
+// and asset threads don't show up: frame() turns it on for the render
+// thread. operator new is replaced here, and SDL (and SDL_ttf / SDL_image,
+// which allocate through it) goes through install_alloc_counting().
+static thread_local bool     t_count_allocs = false;
+static thread_local uint64_t t_alloc_count = 0;
+
+void* operator new(std::size_t size) {
+    if (t_count_allocs) ++t_alloc_count;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
 }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
 
+static SDL_malloc_func  g_sdl_malloc = nullptr;
+static SDL_calloc_func  g_sdl_calloc = nullptr;
+static SDL_realloc_func g_sdl_realloc = nullptr;
+static SDL_free_func    g_sdl_free = nullptr;
 
+static void* SDLCALL counting_malloc(size_t size) {
+    if (t_count_allocs) ++t_alloc_count;
+    return g_sdl_malloc(size);
+}
+static void* SDLCALL counting_calloc(size_t nmemb, size_t size) {
+    if (t_count_allocs) ++t_alloc_count;
+    return g_sdl_calloc(nmemb, size);
+}
+static void* SDLCALL counting_realloc(void* mem, size_t size) {
+    if (t_count_allocs) ++t_alloc_count;
+    return g_sdl_realloc(mem, size);
+}
 
-static uint32_t hash_u32(uint32_t x) {
-    x ^= x >> 16;
-    x *= 0x7feb352d;
-    x ^= x >> 15;
-    x *= 0x846ca68b;
-    x ^= x >> 16;
-    return x;
+// Must run before SDL allocates anything, i.e. before SDL_Init.
+static void install_alloc_counting() {
+    SDL_GetOriginalMemoryFunctions(&g_sdl_malloc, &g_sdl_calloc, &g_sdl_realloc, &g_sdl_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, g_sdl_free);
 }
 
-static float stable_tile_scale(int gx, int gy) {
-    uint32_t h = hash_u32((uint32_t)gx * 73856093u ^ (uint32_t)gy * 19349663u);
-    float t = (h & 0xFFFFu) / 65535.0f;   // 0..1
-    return 0.5f + t * 0.3f;              // 0.5..0.8
+// Move the current frame's numbers into the history. Once per frame.
+static void prof_end_frame() {
+    static const double msPerTick = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+    int slot = g_prof.cursor;
+    for (int s = 0; s < PROF_STAGE_COUNT; ++s) {
+        g_prof.stage_ms[s][slot] = static_cast<float>(g_prof.stage_ticks[s] * msPerTick);
+        g_prof.stage_ticks[s] = 0;
+    }
+    for (int c = 0; c < PROF_COUNTER_COUNT; ++c) {
+        g_prof.counter_hist[c][slot] = g_prof.counters[c];
+        g_prof.counters[c] = 0;
+    }
+    g_prof.cursor = (slot + 1) % PROF_HISTORY;
+    g_prof.filled = std::min(g_prof.filled + 1, PROF_HISTORY);
+    ++g_prof.frames;
 }
 
-static float clamp01(float t) {
-    return std::max(0.0f, std::min(1.0f, t));
+// Drop what a frame that wasn't drawn recorded, so it doesn't land on
+// the next drawn frame.
+static void prof_discard_frame() {
+    for (int s = 0; s < PROF_STAGE_COUNT; ++s) g_prof.stage_ticks[s] = 0;
+    for (int c = 0; c < PROF_COUNTER_COUNT; ++c) g_prof.counters[c] = 0;
 }
 
-static float ease_out_cubic(float t) {
-    t = clamp01(t);
-    float u = 1.0f - t;
-    return 1.0f - u * u * u;
+struct ProfStats {
+    float min = 0.0f, avg = 0.0f, p99 = 0.0f;
+};
+
+static ProfStats prof_stats(const float* samples, int count) {
+    ProfStats st;
+    if (count <= 0) return st;
+
+    static float scratch[PROF_HISTORY];
+    std::copy(samples, samples + count, scratch);
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i) sum += scratch[i];
+
+    int p99 = std::min(count - 1, (count * 99) / 100);
+    std::nth_element(scratch, scratch + p99, scratch + count);
+    st.p99 = scratch[p99];
+    st.min = *std::min_element(scratch, scratch + count);
+    st.avg = sum / count;
+    return st;
 }
 
-// Forward declarations for banner helpers
-static void draw_filled_rounded_rect(SDL_Renderer* renderer,
-    float x, float y, float w, float h,
-    float radius, SDL_Color color);
+// Overlay text with SDL's built-in 8x8 debug font (no TTF involved, so it
+// doesn't disturb the counters it reports).
+static void draw_profiler_overlay(SDL_Renderer* renderer) {
+    if (!renderer || g_prof.filled == 0) return;
+
+    const float lineH = 10.0f;
+    const int   lines = 2 + PROF_STAGE_COUNT + PROF_COUNTER_COUNT;
+    SDL_FRect panel{ 8.0f, 8.0f, 420.0f, lines * lineH + 8.0f };
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
+    SDL_RenderFillRect(renderer, &panel);
+
+    char buf[128];
+    float x = panel.x + 6.0f;
+    float y = panel.y + 4.0f;
+    int count = g_prof.filled;
+
+    ProfStats frameStats = prof_stats(g_prof.stage_ms[PROF_FRAME], count);
+    std::snprintf(buf, sizeof(buf), "%d frames, %.1f fps avg   (F3 hide, F4 csv)",
+        count, frameStats.avg > 0.0f ? 1000.0f / frameStats.avg : 0.0f);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderDebugText(renderer, x, y, buf);
+    y += lineH;
+    SDL_RenderDebugText(renderer, x, y, "stage (ms)       min     avg     p99");
+    y += lineH;
+
+    for (int s = 0; s < PROF_STAGE_COUNT; ++s) {
+        ProfStats st = prof_stats(g_prof.stage_ms[s], count);
+        std::snprintf(buf, sizeof(buf), "%-12s %7.2f %7.2f %7.2f",
+            PROF_STAGE_NAMES[s], st.min, st.avg, st.p99);
+        SDL_RenderDebugText(renderer, x, y, buf);
+        y += lineH;
+    }
 
-static void render_text_centered(SDL_Renderer* renderer,
-    TTF_Font* font,
-    const std::string& text,
-    SDL_Color color,
-    float x, float y);
+    int last = (g_prof.cursor + PROF_HISTORY - 1) % PROF_HISTORY;
+    for (int c = 0; c < PROF_COUNTER_COUNT; ++c) {
+        uint64_t sum = 0;
+        uint32_t peak = 0;
+        for (int i = 0; i < count; ++i) {
+            sum += g_prof.counter_hist[c][i];
+            peak = std::max(peak, g_prof.counter_hist[c][i]);
+        }
+        std::snprintf(buf, sizeof(buf), "%-16s last %5u avg %7.1f max %5u",
+            PROF_COUNTER_NAMES[c], g_prof.counter_hist[c][last],
+            static_cast<double>(sum) / count, peak);
+        SDL_RenderDebugText(renderer, x, y, buf);
+        y += lineH;
+    }
+}
 
-static void render_text_left(SDL_Renderer* renderer,
-                             TTF_Font* font,
-                             const std::string& text,
-                             SDL_Color color,
-                             float x,
-                             float y)
-{
-    if (!renderer || !font) return;
-    if (text.empty()) return;
+// Write the history, oldest frame first. On the web there is no useful
+// filesystem, so the CSV goes to the console instead.
+static void prof_dump_csv() {
+    std::ostringstream csv;
+    csv << "frame";
+    for (const char* name : PROF_STAGE_NAMES) csv << ',' << name << "_ms";
+    for (const char* name : PROF_COUNTER_NAMES) csv << ',' << name;
+    csv << '\n';
+
+    int count = g_prof.filled;
+    int first = (g_prof.cursor + PROF_HISTORY - count) % PROF_HISTORY;
+    uint64_t frameNo = g_prof.frames - static_cast<uint64_t>(count);
+    for (int i = 0; i < count; ++i) {
+        int slot = (first + i) % PROF_HISTORY;
+        csv << frameNo + i;
+        for (int s = 0; s < PROF_STAGE_COUNT; ++s) csv << ',' << g_prof.stage_ms[s][slot];
+        for (int c = 0; c < PROF_COUNTER_COUNT; ++c) csv << ',' << g_prof.counter_hist[c][slot];
+        csv << '\n';
+    }
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), 0, color);
-    if (!surface) {
-        std::cerr << "TTF_RenderText_Blended (left) failed: "
-                  << SDL_GetError() << "\n";
+#ifdef __EMSCRIPTEN__
+    std::cout << csv.str() << std::flush;
+    log_info("[Profiler] Wrote %d frames to the console", count);
+#else
+    std::string path = "profile_" + std::to_string(SDL_GetTicks()) + ".csv";
+    std::ofstream out(path);
+    if (!out) {
+        log_error("[Profiler] Could not write %s", path.c_str());
         return;
     }
+    out << csv.str();
+    log_info("[Profiler] Wrote %d frames to %s", count, path.c_str());
+#endif
+}
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "SDL_CreateTextureFromSurface (left) failed: "
-                  << SDL_GetError() << "\n";
-        SDL_DestroySurface(surface);
-        return;
+// F3 / F4, from either event loop. Returns true if the key was ours.
+static bool prof_handle_key(SDL_Keycode key) {
+    if (key == SDLK_F3) {
+        g_prof.overlay = !g_prof.overlay;
+        return true;
     }
+    if (key == SDLK_F4) {
+        prof_dump_csv();
+        return true;
+    }
+    return false;
+}
 
-    SDL_FRect dst{};
-    dst.w = static_cast<float>(surface->w);
-    dst.h = static_cast<float>(surface->h);
-    dst.x = x;
-    dst.y = y;
 
-    SDL_DestroySurface(surface);
+// ----------------------
+// Frame arena
+// ----------------------
 
-    SDL_RenderTexture(renderer, texture, nullptr, &dst);
-    SDL_DestroyTexture(texture);
+// Bump allocator for data that only lives until frame() returns (today
+// the name list search line). FrameAllocScope rewinds it on the way out
+// of every frame. Blocks are kept across frames and reused; a request the
+// current block can't hold moves on to the next one. Never keep a
+// FrameString past the frame that made it.
+static constexpr size_t FRAME_ARENA_BLOCK = 64 * 1024;
+
+struct FrameArena {
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+    std::vector<size_t> block_sizes;
+    size_t block = 0;  // block being filled
+    size_t used = 0;   // bytes used in it
+};
+
+static FrameArena g_frame_arena;
+
+static void* frame_alloc(size_t size, size_t align) {
+    FrameArena& a = g_frame_arena;
+    for (;;) {
+        if (a.block == a.blocks.size()) {
+            size_t bytes = std::max(FRAME_ARENA_BLOCK, size + align);
+            a.blocks.emplace_back(new unsigned char[bytes]);
+            a.block_sizes.push_back(bytes);
+        }
+        uintptr_t base = reinterpret_cast<uintptr_t>(a.blocks[a.block].get());
+        uintptr_t p = (base + a.used + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        size_t end = static_cast<size_t>(p - base) + size;
+        if (end <= a.block_sizes[a.block]) {
+            a.used = end;
+            return reinterpret_cast<void*>(p);
+        }
+        ++a.block;
+        a.used = 0;
+    }
 }
 
-static void draw_winner_banner(SDL_Renderer* renderer,
-    TTF_Font* font,
-    const std::string& name,
-    SDL_Color barColor,  // kept for signature compatibility
-    float t)
-{
-    (void)barColor; // we now choose our own colors
+static void frame_arena_reset() {
+    g_frame_arena.block = 0;
+    g_frame_arena.used = 0;
+}
 
-    if (!renderer || !font || name.empty()) return;
+template <typename T>
+struct FrameAllocator {
+    using value_type = T;
 
-    int winW = 0, winH = 0;
-    SDL_GetRenderOutputSize(renderer, &winW, &winH);
+    FrameAllocator() = default;
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(frame_alloc(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) {}  // freed all at once by frame_arena_reset()
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) { return false; }
+
+using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+
+// Lifetime of one frame() call: counts the render thread's allocations
+// into t_alloc_count and rewinds the arena on every way out.
+struct FrameAllocScope {
+    FrameAllocScope() {
+        t_alloc_count = 0;
+        t_count_allocs = true;
+    }
+    ~FrameAllocScope() {
+        t_count_allocs = false;
+        frame_arena_reset();
+    }
+    FrameAllocScope(const FrameAllocScope&) = delete;
+    FrameAllocScope& operator=(const FrameAllocScope&) = delete;
+};
+
+// ----------------------
+// Label texture cache
+// ----------------------
+
+// Rasterized name labels, keyed by (font, text, color). Labels are built
+// on the render thread the first frame an entry shows up and live until
+// the wheel is reset, so the per-frame path only issues texture draws.
+struct LabelKey {
+    TTF_Font*   font = nullptr;
+    std::string text;
+    Uint32      rgba = 0;
+
+    bool operator==(const LabelKey& o) const {
+        return font == o.font && rgba == o.rgba && text == o.text;
+    }
+};
+
+struct LabelKeyHash {
+    size_t operator()(const LabelKey& k) const {
+        size_t h = std::hash<std::string>{}(k.text);
+        h ^= std::hash<const void*>{}(k.font) + 0x9e3779b9u + (h << 6) + (h >> 2);
+        h ^= std::hash<Uint32>{}(k.rgba) + 0x9e3779b9u + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+struct LabelTexture {
+    SDL_Texture* texture = nullptr;
+    float w = 0.0f;
+    float h = 0.0f;
+};
+
+static std::unordered_map<LabelKey, LabelTexture, LabelKeyHash> g_label_cache;
+static uint32_t g_label_cache_generation = 0; // bumped on every clear
+
+static Uint32 pack_color(SDL_Color c) {
+    return (Uint32(c.r) << 24) | (Uint32(c.g) << 16) | (Uint32(c.b) << 8) | Uint32(c.a);
+}
+
+// Returns the cached label for (font, text, color), rasterizing it on a miss.
+// Returns nullptr if the text is empty or rasterization failed.
+static const LabelTexture* get_label_texture(SDL_Renderer* renderer,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color)
+{
+    if (!renderer || !font || text.empty()) return nullptr;
+
+    // Reuse one probe key so a cache hit doesn't allocate
+    static LabelKey probe;
+    probe.font = font;
+    probe.text.assign(text.data(), text.size());
+    probe.rgba = pack_color(color);
+
+    auto it = g_label_cache.find(probe);
+    if (it != g_label_cache.end()) {
+        return &it->second;
+    }
+
+    prof_count(PROF_TTF_RENDERS);
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.data(), text.size(), color);
+    if (!surface) {
+        std::cerr << "TTF_RenderText_Blended (label) failed: "
+                  << SDL_GetError() << "\n";
+        return nullptr;
+    }
+
+    prof_count(PROF_TEXTURES_CREATED);
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        std::cerr << "SDL_CreateTextureFromSurface (label) failed: "
+                  << SDL_GetError() << "\n";
+        SDL_DestroySurface(surface);
+        return nullptr;
+    }
+
+    LabelTexture label;
+    label.texture = texture;
+    label.w = static_cast<float>(surface->w);
+    label.h = static_cast<float>(surface->h);
+    SDL_DestroySurface(surface);
+
+    auto inserted = g_label_cache.emplace(probe, label);
+    return &inserted.first->second;
+}
+
+// Per-entry label handles, parallel to EntryStore. Filled on the render
+// thread by warm_entry_labels(); a null handle is resolved on first draw.
+struct EntryLabels {
+    std::vector<const LabelTexture*> wheel;      // readable color for the slice
+    std::vector<const LabelTexture*> wheel_dark; // black, active / winner slice
+    std::vector<const LabelTexture*> list;       // name list (without a text engine)
+    std::vector<TTF_Text*>           list_text;  // name list (g_text_engine)
+    size_t warmed = 0;                           // entries seen by warm_entry_labels
+};
+
+static EntryLabels g_entry_labels;
+
+static const LabelTexture* entry_label(SDL_Renderer* renderer,
+    std::vector<const LabelTexture*>& handles,
+    size_t index,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color)
+{
+    if (index >= handles.size()) {
+        handles.resize(index + 1, nullptr);
+    }
+    if (!handles[index]) {
+        handles[index] = get_label_texture(renderer, font, text, color);
+    }
+    return handles[index];
+}
+
+// Destroy every cached label (called when the wheel is reset)
+static void label_cache_clear() {
+    for (auto& kv : g_label_cache) {
+        if (kv.second.texture) {
+            SDL_DestroyTexture(kv.second.texture);
+        }
+    }
+    g_label_cache.clear();
+    ++g_label_cache_generation;
+
+    g_entry_labels.wheel.clear();
+    g_entry_labels.wheel_dark.clear();
+    g_entry_labels.list.clear();
+    for (TTF_Text* text : g_entry_labels.list_text) {
+        if (text) TTF_DestroyText(text);
+    }
+    g_entry_labels.list_text.clear();
+    g_entry_labels.warmed = 0;
+}
+
+// SDL_ttf's renderer text engine, used for unrotated text (the name list).
+// It shapes each string once and draws it as quads from glyph atlases
+// shared by every font, so a new name only costs the glyphs not seen yet.
+// Rotated wheel labels stay cached textures. nullptr = labels everywhere.
+static TTF_TextEngine* g_text_engine = nullptr;
+
+static void text_engine_open(SDL_Renderer* renderer) {
+    g_text_engine = TTF_CreateRendererTextEngine(renderer);
+    if (!g_text_engine) {
+        log_warn("[Text] No renderer text engine (%s); using label textures", SDL_GetError());
+    }
+}
+
+// Call after label_cache_clear(): TTF_Text objects must go first.
+static void text_engine_close() {
+    if (g_text_engine) {
+        TTF_DestroyRendererTextEngine(g_text_engine);
+        g_text_engine = nullptr;
+    }
+}
+
+static TTF_Text* entry_list_text(size_t index, TTF_Font* font, std::string_view name) {
+    std::vector<TTF_Text*>& texts = g_entry_labels.list_text;
+    if (index >= texts.size()) {
+        texts.resize(index + 1, nullptr);
+    }
+    if (!texts[index]) {
+        texts[index] = TTF_CreateText(g_text_engine, font, name.data(), name.size());
+        if (texts[index]) {
+            TTF_SetTextColor(texts[index], 0, 0, 0, 255);
+        }
+    }
+    return texts[index];
+}
+
+// Retained text for HUD strings drawn every frame: one texture, rebuilt
+// only when the string, font or color changes, so steady frames do no
+// font work. Unlike cached labels it survives label_cache_clear().
+struct TextWidget {
+    SDL_Texture* texture = nullptr;
+    std::string  text;
+    TTF_Font*    font = nullptr;
+    SDL_Color    color{ 0, 0, 0, 0 };
+    float        w = 0.0f;
+    float        h = 0.0f;
+};
+
+static TextWidget g_status_text; // status pill
+static TextWidget g_hold_text;   // "hold for one second to reset..."
+static TextWidget g_search_text; // name list "find: ..." line
+
+static void text_widget_release(TextWidget& t) {
+    if (t.texture) {
+        SDL_DestroyTexture(t.texture);
+    }
+    t = TextWidget{};
+}
+
+// Returns the widget ready to draw, or nullptr if there is nothing to show.
+static const TextWidget* text_widget_update(SDL_Renderer* renderer,
+    TextWidget& t,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color)
+{
+    if (!renderer || !font || text.empty()) return nullptr;
+
+    if (t.texture && t.font == font && t.text == text &&
+        pack_color(t.color) == pack_color(color)) {
+        return &t;
+    }
+
+    text_widget_release(t);
+    prof_count(PROF_TTF_RENDERS);
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.data(), text.size(), color);
+    if (!surface) return nullptr;
+    prof_count(PROF_TEXTURES_CREATED);
+    t.texture = SDL_CreateTextureFromSurface(renderer, surface);
+    t.w = static_cast<float>(surface->w);
+    t.h = static_cast<float>(surface->h);
+    SDL_DestroySurface(surface);
+    if (!t.texture) return nullptr;
+
+    t.text.assign(text.data(), text.size());
+    t.font = font;
+    t.color = color;
+    return &t;
+}
+
+static void render_text_bottom_right(SDL_Renderer* renderer,
+    TTF_Font* font,
+    const std::string& text,
+    SDL_Color color,
+    float x,
+    float y)
+{
+    if (!renderer || !font) return;
+    if (text.empty()) return;
+
+    prof_count(PROF_TTF_RENDERS);
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), 0, color);
+    if (!surface) {
+        std::cerr << "TTF_RenderText_Blended (bottom-right) failed: "
+                  << SDL_GetError() << "\n";
+        return;
+    }
+
+    prof_count(PROF_TEXTURES_CREATED);
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        std::cerr << "SDL_CreateTextureFromSurface (bottom-right) failed: "
+                  << SDL_GetError() << "\n";
+        SDL_DestroySurface(surface);
+        return;
+    }
+
+    SDL_FRect dst{};
+    dst.w = static_cast<float>(surface->w);
+    dst.h = static_cast<float>(surface->h);
+
+    // (x, y) is the bottom-right corner
+    dst.x = x - dst.w;
+    dst.y = y - dst.h;
+
+    SDL_DestroySurface(surface);
+
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderTexture(renderer, texture, nullptr, &dst);
+    SDL_DestroyTexture(texture);
+}
+
+
+static void trim_in_place(std::string& s) {
+    size_t first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        s.clear();
+        return;
+    }
+    size_t last = s.find_last_not_of(" \t\r\n");
+    s = s.substr(first, last - first + 1);
+}
+
+static std::string to_lower(const std::string& s);
+
+// Append a comma-separated channel list ("a, #B,c") to cfg.channels,
+// normalized to "#name" lowercase and without duplicates. The first
+// channel seen becomes cfg.channel, the host channel.
+static void add_config_channels(TwitchConfig& cfg, const std::string& list) {
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        trim_in_place(item);
+        if (!item.empty() && item[0] == '#') item.erase(0, 1);
+        if (item.empty()) continue;
+
+        std::string ch = "#" + to_lower(item);
+        if (std::find(cfg.channels.begin(), cfg.channels.end(), ch) != cfg.channels.end()) {
+            continue;
+        }
+        if (cfg.channels.size() >= MAX_TWITCH_CHANNELS) {
+            log_warn("[Twitch] More than %zu channels configured; ignoring %s",
+                MAX_TWITCH_CHANNELS, ch.c_str());
+            continue;
+        }
+        cfg.channels.push_back(ch);
+    }
+    if (cfg.channel.empty() && !cfg.channels.empty()) {
+        cfg.channel = cfg.channels.front();
+    }
+}
+
+static bool load_twitch_config(const char* path, TwitchConfig& out) {
+    std::ifstream in(path);
+    if (!in) {
+        log_warn("[Twitch] Could not open config file: %s", path);
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        trim_in_place(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+
+        std::string key = line.substr(0, eq);
+        std::string value = line.substr(eq + 1);
+        trim_in_place(key);
+        trim_in_place(value);
+
+        std::string lkey = to_lower(key);
+        if (lkey == "oauth") {
+            out.oauth = value;
+        }
+        else if (lkey == "nick") {
+            out.nick = value;
+        }
+        else if (lkey == "channel" || lkey == "channels") {
+            add_config_channels(out, value);
+        }
+        else if (lkey == "animate_background") {
+            out.animate_background = !(value == "0" || to_lower(value) == "false");
+        }
+        else if (lkey == "sub_tickets" || lkey == "max_tickets") {
+            char* end = nullptr;
+            long n = std::strtol(value.c_str(), &end, 10);
+            if (end != value.c_str() && *end == '\0') {
+                int tickets = static_cast<int>(std::clamp<long>(n, 1, MAX_ENTRY_TICKETS));
+                (lkey == "sub_tickets" ? out.sub_tickets : out.max_tickets) = tickets;
+            }
+            else {
+                log_warn("[Twitch] Bad %s '%s' in %s", lkey.c_str(), value.c_str(), path);
+            }
+        }
+        else if (lkey == "command_window_ms" || lkey == "user_commands_per_min" ||
+                 lkey == "commands_per_sec") {
+            char* end = nullptr;
+            long n = std::strtol(value.c_str(), &end, 10);
+            if (end != value.c_str() && *end == '\0' && n >= 0) {
+                int v = static_cast<int>(std::min<long>(n, MAX_COMMAND_LIMIT));
+                (lkey == "command_window_ms" ? out.command_window_ms
+                    : lkey == "user_commands_per_min" ? out.user_commands_per_min
+                    : out.commands_per_sec) = v;
+            }
+            else {
+                log_warn("[Twitch] Bad %s '%s' in %s", lkey.c_str(), value.c_str(), path);
+            }
+        }
+        else if (lkey == "background_sprites") {
+            char* end = nullptr;
+            long n = std::strtol(value.c_str(), &end, 10);
+            if (end != value.c_str() && *end == '\0') {
+                out.background_sprites = static_cast<int>(
+                    std::clamp<long>(n, 0, MAX_BACKGROUND_SPRITES));
+            }
+            else {
+                log_warn("[Twitch] Bad background_sprites '%s' in %s", value.c_str(), path);
+            }
+        }
+        else if (lkey == "journal") {
+            out.journal = value;
+        }
+        else if (lkey == "spin_seed") {
+            char* end = nullptr;
+            unsigned long long seed = std::strtoull(value.c_str(), &end, 16);
+            if (end != value.c_str() && *end == '\0') {
+                out.seeded_spins = true;
+                out.spin_seed = seed;
+            }
+            else {
+                log_warn("[Twitch] Bad spin_seed '%s' in %s", value.c_str(), path);
+            }
+        }
+        else if (lkey == "log_level") {
+            LogLevel level;
+            if (parse_log_level(to_lower(value), level)) {
+                g_log.min_level.store(level);
+            }
+            else {
+                log_warn("[Twitch] Unknown log_level '%s' in %s", value.c_str(), path);
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// ----------------------
+// Utility: RNG, colors
+// ----------------------
+
+static void draw_filled_triangle(SDL_Renderer* renderer,
+    SDL_FPoint a, SDL_FPoint b, SDL_FPoint c, SDL_Color color);
+
+static void draw_spin_droplet(SDL_Renderer* renderer,
+    float cx, float cy, float r, SDL_Color color);
+
+
+static std::mt19937& global_rng() {
+    static std::mt19937 rng{ std::random_device{}() };
+    return rng;
+}
+
+// Replace the existing random_color() with this version
+static SDL_Color random_color() {
+    static const SDL_Color palette[] = {
+        { 0,   100, 0,   255 },  // dark green
+        { 100, 170, 120, 255 },  // light green
+        { 255, 165, 0,   255 },  // orange
+        { 240, 210, 60,  255  }
+    };
+
+    static std::atomic<uint32_t> idx{ 0 };
+    uint32_t i = idx.fetch_add(1, std::memory_order_relaxed);
+    return palette[i % (sizeof(palette) / sizeof(palette[0]))];
+}
+
+
+
+static uint32_t hash_u32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
+
+static float stable_tile_scale(int gx, int gy) {
+    uint32_t h = hash_u32((uint32_t)gx * 73856093u ^ (uint32_t)gy * 19349663u);
+    float t = (h & 0xFFFFu) / 65535.0f;   // 0..1
+    return 0.5f + t * 0.3f;              // 0.5..0.8
+}
+
+static float clamp01(float t) {
+    return std::max(0.0f, std::min(1.0f, t));
+}
+
+static float ease_out_cubic(float t) {
+    t = clamp01(t);
+    float u = 1.0f - t;
+    return 1.0f - u * u * u;
+}
+
+// Forward declarations for banner helpers
+static void draw_filled_rounded_rect(SDL_Renderer* renderer,
+    float x, float y, float w, float h,
+    float radius, SDL_Color color);
+
+static void render_label_left(SDL_Renderer* renderer,
+                              const LabelTexture* label,
+                              float x,
+                              float y)
+{
+    if (!renderer || !label) return;
+
+    SDL_FRect dst{};
+    dst.w = label->w;
+    dst.h = label->h;
+    dst.x = x;
+    dst.y = y;
+
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderTexture(renderer, label->texture, nullptr, &dst);
+}
+
+static void render_text_left(SDL_Renderer* renderer,
+                             TTF_Font* font,
+                             std::string_view text,
+                             SDL_Color color,
+                             float x,
+                             float y)
+{
+    render_label_left(renderer, get_label_texture(renderer, font, text, color), x, y);
+}
+
+// Winner banner timing: slide in, then reveal one letter per interval
+static constexpr float BANNER_SLIDE_IN_SEC = 0.35f;
+static constexpr float BANNER_LETTER_START_SEC = 0.35f;
+static constexpr float BANNER_LETTER_INTERVAL_SEC = 0.07f;
+
+// Seconds until the banner for `name` stops changing
+static float banner_reveal_seconds(const std::string& name) {
+    return std::max(BANNER_SLIDE_IN_SEC,
+        BANNER_LETTER_START_SEC + BANNER_LETTER_INTERVAL_SEC * static_cast<float>(name.size()));
+}
+
+static void draw_winner_banner(SDL_Renderer* renderer,
+    TTF_Font* font,
+    const std::string& name,
+    SDL_Color barColor,  // kept for signature compatibility
+    float t)
+{
+    (void)barColor; // we now choose our own colors
+
+    if (!renderer || !font || name.empty()) return;
+
+    int winW = 0, winH = 0;
+    SDL_GetRenderOutputSize(renderer, &winW, &winH);
 
     const float barH = 90.0f;
 
@@ -337,7 +1371,7 @@ static void draw_winner_banner(SDL_Renderer* renderer,
 
 
     // Slide-in duration
-    const float slideInDur = 0.35f;
+    const float slideInDur = BANNER_SLIDE_IN_SEC;
 
     // Clamp time for sliding; once in place, stay put
     float tClamped = (slideInDur > 0.0f)
@@ -396,13 +1430,14 @@ if (app.waka_texture && app.waka_w > 0 && app.waka_h > 0) {
     dst.x = innerX;
     dst.y = innerY;
 
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderTexture(renderer, app.waka_texture, &src, &dst);
 }
 
 
     // Letters still appear one at a time, but no vertical "shake"
-    const float letterStart    = 0.35f;
-    const float letterInterval = 0.07f;
+    const float letterStart    = BANNER_LETTER_START_SEC;
+    const float letterInterval = BANNER_LETTER_INTERVAL_SEC;
 
     int lettersShown = 0;
     if (t >= letterStart) {
@@ -416,62 +1451,666 @@ if (app.waka_texture && app.waka_w > 0 && app.waka_h > 0) {
         return;
     }
 
-    std::string sub = name.substr(0, lettersShown);
-
-    // Name stays centered on the banner
-    render_text_centered(renderer,
-        font,
-        sub,
-        SDL_Color{ 255, 255, 255, 255 }, // white text
-        barCenterX,
-        barY);
-}
+    // One label for the whole name (usually pre-rasterized at spin start),
+    // drawn clipped to the revealed prefix instead of re-rendering the
+    // substring every frame.
+    const LabelTexture* label =
+        get_label_texture(renderer, font, name, SDL_Color{ 255, 255, 255, 255 });
+    if (!label) return;
+
+    int prefixW = 0;
+    if (!TTF_GetStringSize(font, name.c_str(), static_cast<size_t>(lettersShown), &prefixW, nullptr)) {
+        prefixW = static_cast<int>(label->w);
+    }
+    float shownW = std::min(static_cast<float>(prefixW), label->w);
+
+    // Name stays centered on the banner
+    SDL_FRect src{ 0.0f, 0.0f, shownW, label->h };
+    SDL_FRect dst{ barCenterX - shownW * 0.5f, barY - label->h * 0.5f, shownW, label->h };
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderTexture(renderer, label->texture, &src, &dst);
+}
+
+
+static std::string to_lower(const std::string& s) {
+    std::string out = s;
+    std::transform(out.begin(), out.end(), out.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+// Case folding for names (dedupe keys and list search). Covers the cased
+// scripts Twitch display names use in practice: ASCII, Latin-1 and Latin
+// Extended-A, Greek, Cyrillic, Armenian and fullwidth Latin. CJK, Hangul
+// and emoji have no case and pass through, as do invalid UTF-8 bytes.
+static uint32_t fold_code_point(uint32_t c) {
+    if (c < 0x80) {
+        return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+    }
+    if (c >= 0x00C0 && c <= 0x00DE && c != 0x00D7) return c + 32;
+    if (c >= 0x0100 && c <= 0x017F) {
+        if (c == 0x0130) return 'i';                // dotted capital I
+        if (c == 0x0178) return 0x00FF;             // Y with diaeresis
+        if (c == 0x017F) return 's';                // long s
+        bool oddUpper = (c >= 0x0139 && c <= 0x0148) || (c >= 0x0179 && c <= 0x017E);
+        if (oddUpper) return (c & 1) ? c + 1 : c;
+        if (c == 0x0138 || c == 0x0149) return c;   // kra, n-apostrophe: no case
+        return (c & 1) ? c : c + 1;
+    }
+    if (c >= 0x0391 && c <= 0x03A9 && c != 0x03A2) return c + 32;
+    if (c == 0x03C2) return 0x03C3;                 // final sigma
+    if (c >= 0x0400 && c <= 0x040F) return c + 80;
+    if (c >= 0x0410 && c <= 0x042F) return c + 32;
+    if (c >= 0x0531 && c <= 0x0556) return c + 48;
+    if (c >= 0xFF21 && c <= 0xFF3A) return c + 32;
+    return c;
+}
+
+static void append_utf8(std::string& out, uint32_t c) {
+    if (c < 0x80) {
+        out.push_back(static_cast<char>(c));
+    }
+    else if (c < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (c >> 6)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+    else if (c < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (c >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+    else {
+        out.push_back(static_cast<char>(0xF0 | (c >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+    }
+}
+
+static void fold_case_into(std::string& out, std::string_view s) {
+    out.clear();
+    out.reserve(s.size());
+    size_t i = 0;
+    while (i < s.size()) {
+        unsigned char b = static_cast<unsigned char>(s[i]);
+        int len = (b < 0x80) ? 1 : (b >> 5) == 0x6 ? 2 : (b >> 4) == 0xE ? 3 : (b >> 3) == 0x1E ? 4 : 0;
+        bool valid = len > 0 && i + len <= s.size();
+        uint32_t c = (len == 1) ? b : (len == 2) ? (b & 0x1F) : (len == 3) ? (b & 0x0F) : (b & 0x07);
+        for (int k = 1; valid && k < len; ++k) {
+            unsigned char cont = static_cast<unsigned char>(s[i + k]);
+            valid = (cont & 0xC0) == 0x80;
+            c = (c << 6) | (cont & 0x3F);
+        }
+        if (!valid) {
+            out.push_back(s[i++]); // not UTF-8; keep the byte
+            continue;
+        }
+        if (len == 1) {
+            out.push_back(static_cast<char>(fold_code_point(c)));
+        }
+        else {
+            uint32_t f = fold_code_point(c);
+            if (f == c) out.append(s.data() + i, len);
+            else        append_utf8(out, f);
+        }
+        i += len;
+    }
+}
+
+static std::string fold_case(std::string_view s) {
+    std::string out;
+    fold_case_into(out, s);
+    return out;
+}
+
+static bool is_stream_allowed(const std::string& nick, const std::string& channel)
+{
+    // All names here should be lowercase. Add/remove entries as needed.
+    static const char* ALLOWED[] = {
+        "cbf01",       // example allowed channel/host
+        "shoepert",
+        
+    };
+
+    std::string n  = to_lower(nick);
+
+    std::string ch = channel;
+    if (!ch.empty() && ch[0] == '#') {
+        ch.erase(0, 1); // strip leading '#'
+    }
+    ch = to_lower(ch);
+
+    for (const char* allowed : ALLOWED) {
+        if (n == allowed || ch == allowed) {
+            return true;
+        }
+    }
+    return false;
+}
+// Journal hooks (see "Journal")
+static void journal_add(const AppState& a, size_t index);
+static void journal_tickets(const AppState& a, size_t index);
+static void journal_reset();
+
+// Dedupe is case-insensitive (fold_case) and O(1) via entry_keys.
+// Caller must hold entries_mutex.
+static bool add_entry_locked(AppState& a, const std::string& name, SDL_Color color,
+    uint32_t tickets)
+{
+    if (name.empty()) return false;
+    uint32_t index = static_cast<uint32_t>(a.entries.size());
+    if (!a.entry_keys.emplace(fold_case(name), index).second) {
+        return false; // already on the wheel
+    }
+    a.entries.push_back(name, color, tickets);
+    a.entries_version.fetch_add(1, std::memory_order_release);
+    journal_add(a, index);
+    return true;
+}
+
+static bool add_player_locked(AppState& a, const std::string& name, uint32_t tickets = 1) {
+    return add_entry_locked(a, name, random_color(), tickets);
+}
+
+enum class JoinResult { None, Added, Bonus };
+
+// A chat !join: new players get one ticket (sub_tickets for subscribers);
+// a repeat !join adds one more, up to max_tickets.
+// Caller must hold entries_mutex.
+static JoinResult join_player_locked(AppState& a, const std::string& name, bool subscriber) {
+    if (name.empty()) return JoinResult::None;
+    auto it = a.entry_keys.find(fold_case(name));
+    if (it == a.entry_keys.end()) {
+        add_player_locked(a, name, subscriber ? a.sub_tickets : 1);
+        return JoinResult::Added;
+    }
+    uint32_t index = it->second;
+    if (a.entries.weights[index] >= a.max_tickets) {
+        return JoinResult::None;
+    }
+    a.entries.add_weight(index, 1);
+    a.entries_version.fetch_add(1, std::memory_order_release);
+    journal_tickets(a, index);
+    return JoinResult::Bonus;
+}
+
+static void add_player_if_new(AppState& a, const std::string& name) {
+    if (name.empty()) return;
+    bool added = false;
+    {
+        std::lock_guard<std::mutex> lock(a.entries_mutex);
+        added = add_player_locked(a, name);
+    }
+    if (added) {
+        log_info("[Twitch] Added player: %s", name.c_str());
+    }
+}
+
+// Caller must hold entries_mutex.
+static void clear_entries_locked(AppState& a) {
+    a.entries.clear();
+    a.entry_keys.clear();
+    a.entries_version.fetch_add(1, std::memory_order_release);
+    journal_reset();
+}
+
+// Current entry snapshot for drawing. Copies entries only when a join or
+// reset has bumped entries_version since the last call; otherwise it is
+// free. Render thread only.
+static const EntryStore& acquire_entries_snapshot(AppState& a) {
+    uint64_t version = a.entries_version.load(std::memory_order_acquire);
+    if (!a.entries_snapshot || version != a.snapshot_version) {
+        std::lock_guard<std::mutex> lock(a.entries_mutex);
+        a.entries_snapshot = std::make_shared<const EntryStore>(a.entries);
+        a.snapshot_version = a.entries_version.load(std::memory_order_relaxed);
+    }
+    return *a.entries_snapshot;
+}
+
+// Registered at startup; posted to wake an idle main loop
+Uint32 g_wake_event = 0;
+
+// Chat thread, after a successful push: if the main loop is parked in
+// idle_wait(), post an event so it takes the command now rather than at
+// the end of its sleep. Pairs with the fence in idle_wait().
+static void notify_command_queued(AppState& a) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (a.idle_waiting.load(std::memory_order_relaxed) &&
+        a.idle_waiting.exchange(false) && g_wake_event != 0) {
+        SDL_Event ev{};
+        ev.type = g_wake_event;
+        SDL_PushEvent(&ev);
+    }
+}
+
+// From any thread: hand a command to the next frame. Never blocks.
+static void queue_chat_command(AppState& a, ChatCommand&& cmd) {
+    if (!a.command_queue.push(std::move(cmd))) {
+        a.command_queue_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        notify_command_queued(a);
+    }
+}
+
+// Set up one ChannelStats per configured channel. Call before the chat
+// thread starts; the list must not change while it runs.
+static void init_channel_stats(AppState& a, const std::vector<std::string>& channels) {
+    a.channel_stats = std::vector<ChannelStats>(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        a.channel_stats[i].name = channels[i];
+    }
+}
+
+static void log_channel_stats(const AppState& a) {
+    for (const ChannelStats& ch : a.channel_stats) {
+        log_info("[Twitch] %s: %u !join(s), %u added", ch.name.c_str(),
+            ch.joins.load(std::memory_order_relaxed),
+            ch.added.load(std::memory_order_relaxed));
+    }
+}
+
+
+// ----------------------
+// Journal
+// ----------------------
+
+// Append-only record of wheel changes, so a crash or a browser refresh
+// mid-event doesn't lose the wheel. Records gathered during a frame are
+// written with one fwrite at the end of it. Startup replays the file,
+// then rewrites it as a compact snapshot (one Add per entry plus recent
+// winners); the same happens whenever the log grows well past the state
+// it describes.
+//
+// File: "SPWJ" + u32 format version, then records laid out as
+//   u8 op | u8 name length | u16 tickets | u32 arg | name bytes
+// with every field little-endian. A torn record at the tail (crash during
+// a write) ends the replay; the compaction right after drops it.
+//
+// The web build keeps the file in IDBFS (link with -lidbfs.js) and syncs
+// it to IndexedDB at most once per JOURNAL_SYNC_MS.
+enum class JournalOp : uint8_t {
+    Add     = 1,  // name, tickets, arg = RGBA color
+    Tickets = 2,  // tickets = new count, arg = entry index
+    Reset   = 3,
+    Winner  = 4,  // name
+};
+
+static constexpr char     JOURNAL_MAGIC[4] = { 'S', 'P', 'W', 'J' };
+static constexpr uint32_t JOURNAL_VERSION = 1;
+static constexpr size_t   JOURNAL_HEADER_BYTES = 8;
+static constexpr size_t   JOURNAL_RECORD_BYTES = 8;   // before the name
+static constexpr uint32_t JOURNAL_COMPACT_MIN = 4096; // records before compaction is considered
+static constexpr size_t   JOURNAL_HISTORY = 20;       // winners kept across compactions
+static constexpr Uint64   JOURNAL_SYNC_MS = 1000;
+
+struct Journal {
+    std::string path;
+    std::FILE*  file = nullptr;
+    bool        recording = false;   // false while replaying or disabled
+    std::string pending;             // encoded records not yet written
+    uint32_t    records = 0;         // records in the file (written or pending)
+    bool        compact_failed = false; // don't retry the rewrite every frame
+    std::vector<std::string> winners; // oldest first, at most JOURNAL_HISTORY
+#ifdef __EMSCRIPTEN__
+    bool        sync_pending = false;
+    Uint64      last_sync_ms = 0;
+#endif
+};
+
+static Journal g_journal;
+
+static void journal_put_u16(std::string& out, uint16_t v) {
+    out.push_back(static_cast<char>(v & 0xFF));
+    out.push_back(static_cast<char>(v >> 8));
+}
+
+static void journal_put_u32(std::string& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>((v >> (8 * i)) & 0xFF));
+    }
+}
+
+static uint16_t journal_get_u16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+static uint32_t journal_get_u32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+        (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static void journal_encode(std::string& out, JournalOp op, std::string_view name,
+    uint32_t tickets, uint32_t arg)
+{
+    name = name.substr(0, 255);
+    out.push_back(static_cast<char>(op));
+    out.push_back(static_cast<char>(name.size()));
+    journal_put_u16(out, static_cast<uint16_t>(std::min<uint32_t>(tickets, 0xFFFF)));
+    journal_put_u32(out, arg);
+    out.append(name.data(), name.size());
+}
+
+// Inverse of pack_color()
+static SDL_Color unpack_color(uint32_t v) {
+    return SDL_Color{ static_cast<Uint8>(v >> 24), static_cast<Uint8>(v >> 16),
+        static_cast<Uint8>(v >> 8), static_cast<Uint8>(v) };
+}
+
+static void journal_record(JournalOp op, std::string_view name, uint32_t tickets, uint32_t arg) {
+    if (!g_journal.recording) return;
+    journal_encode(g_journal.pending, op, name, tickets, arg);
+    ++g_journal.records;
+}
+
+static void journal_add(const AppState& a, size_t index) {
+    journal_record(JournalOp::Add, a.entries.name(index),
+        a.entries.weights[index], pack_color(a.entries.colors[index]));
+}
+
+static void journal_tickets(const AppState& a, size_t index) {
+    journal_record(JournalOp::Tickets, {}, a.entries.weights[index],
+        static_cast<uint32_t>(index));
+}
+
+static void journal_reset() {
+    journal_record(JournalOp::Reset, {}, 0, 0);
+}
+
+static void journal_remember_winner(std::string_view name) {
+    std::vector<std::string>& w = g_journal.winners;
+    w.emplace_back(name);
+    if (w.size() > JOURNAL_HISTORY) {
+        w.erase(w.begin(), w.end() - JOURNAL_HISTORY);
+    }
+}
+
+static void journal_winner(std::string_view name) {
+    journal_remember_winner(name);
+    journal_record(JournalOp::Winner, name, 0, 0);
+}
+
+// Apply a journal image to the (empty or host-only) wheel.
+// Returns the number of records read. Caller must hold entries_mutex.
+static uint32_t journal_replay_locked(AppState& a, const std::string& data) {
+    if (data.size() < JOURNAL_HEADER_BYTES ||
+        std::memcmp(data.data(), JOURNAL_MAGIC, 4) != 0) {
+        return 0;
+    }
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+    if (journal_get_u32(p + 4) != JOURNAL_VERSION) {
+        log_warn("[Journal] %s has an unknown format version; ignoring it",
+            g_journal.path.c_str());
+        return 0;
+    }
+
+    // Journal entry index -> wheel index (they differ if the host was
+    // added before the replay)
+    std::vector<uint32_t> remap;
+
+    uint32_t records = 0;
+    size_t pos = JOURNAL_HEADER_BYTES;
+    while (pos + JOURNAL_RECORD_BYTES <= data.size()) {
+        const unsigned char* r = p + pos;
+        size_t nameLen = r[1];
+        if (pos + JOURNAL_RECORD_BYTES + nameLen > data.size()) {
+            break; // torn tail
+        }
+        auto op = static_cast<JournalOp>(r[0]);
+        uint32_t tickets = journal_get_u16(r + 2);
+        uint32_t arg = journal_get_u32(r + 4);
+        std::string_view name(data.data() + pos + JOURNAL_RECORD_BYTES, nameLen);
+        pos += JOURNAL_RECORD_BYTES + nameLen;
+        ++records;
+
+        switch (op) {
+        case JournalOp::Add: {
+            std::string user(name);
+            add_entry_locked(a, user, unpack_color(arg), tickets);
+            auto it = a.entry_keys.find(fold_case(user));
+            if (it != a.entry_keys.end()) {
+                remap.push_back(it->second);
+            }
+            break;
+        }
+        case JournalOp::Tickets:
+            if (arg < remap.size()) {
+                uint32_t index = remap[arg];
+                if (tickets > a.entries.weights[index]) {
+                    a.entries.add_weight(index, tickets - a.entries.weights[index]);
+                    a.entries_version.fetch_add(1, std::memory_order_release);
+                }
+            }
+            break;
+        case JournalOp::Reset:
+            clear_entries_locked(a);
+            remap.clear();
+            break;
+        case JournalOp::Winner:
+            journal_remember_winner(name);
+            break;
+        default:
+            log_warn("[Journal] Unknown record type %u; stopping replay", r[0]);
+            return records;
+        }
+    }
+    return records;
+}
+
+// Move `from` over `to` in one step, so `to` is always either the old or
+// the new file. POSIX rename() replaces atomically; Windows' doesn't
+// replace at all, so it goes through MoveFileExW (paths converted the way
+// the narrow fopen() reads them).
+static bool journal_replace_file(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    auto widen = [](const std::string& s) {
+        std::wstring w;
+        int len = MultiByteToWideChar(CP_ACP, 0, s.c_str(), -1, nullptr, 0);
+        if (len > 0) {
+            w.resize(static_cast<size_t>(len));
+            MultiByteToWideChar(CP_ACP, 0, s.c_str(), -1, &w[0], len);
+        }
+        return w;
+    };
+    std::wstring wfrom = widen(from);
+    std::wstring wto = widen(to);
+    return !wfrom.empty() && !wto.empty() &&
+        MoveFileExW(wfrom.c_str(), wto.c_str(),
+            MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
+// Rewrite the file as the current state, via a temp file so a crash
+// mid-rewrite leaves the old journal in place. Caller must hold
+// entries_mutex. On success pending records are folded in (they describe
+// the same state) and dropped; on failure they stay for journal_flush()
+// to append to the old file as usual.
+static bool journal_compact_locked(const AppState& a) {
+    Journal& j = g_journal;
+
+    std::string image(JOURNAL_MAGIC, 4);
+    journal_put_u32(image, JOURNAL_VERSION);
+    uint32_t records = 0;
+    for (size_t i = 0; i < a.entries.size(); ++i, ++records) {
+        journal_encode(image, JournalOp::Add, a.entries.name(i),
+            a.entries.weights[i], pack_color(a.entries.colors[i]));
+    }
+    for (const std::string& name : j.winners) {
+        journal_encode(image, JournalOp::Winner, name, 0, 0);
+        ++records;
+    }
+
+    if (j.file) {
+        std::fclose(j.file);
+        j.file = nullptr;
+    }
+
+    std::string tmp = j.path + ".tmp";
+    bool ok = false;
+    if (std::FILE* out = std::fopen(tmp.c_str(), "wb")) {
+        ok = std::fwrite(image.data(), 1, image.size(), out) == image.size();
+        ok = (std::fclose(out) == 0) && ok;
+    }
+    if (ok) {
+        ok = journal_replace_file(tmp, j.path);
+    }
+    j.compact_failed = !ok;
+    if (ok) {
+        j.pending.clear();
+        j.records = records;
+    }
+    else {
+        log_error("[Journal] Could not rewrite %s; appending to it instead", j.path.c_str());
+        std::remove(tmp.c_str());
+    }
+
+    j.file = std::fopen(j.path.c_str(), "ab");
+    if (!j.file) {
+        log_error("[Journal] Could not open %s; wheel changes won't be saved", j.path.c_str());
+        j.recording = false;
+    }
+#ifdef __EMSCRIPTEN__
+    j.sync_pending = true;
+#endif
+    return ok;
+}
+
+// Replay `path` into the wheel and start recording to it. Empty path
+// disables the journal.
+static void wheel_texture_invalidate();
+
+static void journal_open(AppState& a, const std::string& path) {
+    Journal& j = g_journal;
+    j.path = path;
+    if (path.empty()) return;
+
+    // A finished rewrite that never got renamed over a missing journal.
+    // With the journal present, a leftover temp file is at best partial.
+    std::string tmp = path + ".tmp";
+    if (std::FILE* probe = std::fopen(path.c_str(), "rb")) {
+        std::fclose(probe);
+        std::remove(tmp.c_str());
+    }
+    else if (journal_replace_file(tmp, path)) {
+        log_warn("[Journal] Recovered %s from %s", path.c_str(), tmp.c_str());
+    }
+
+    std::string data;
+    if (std::FILE* in = std::fopen(path.c_str(), "rb")) {
+        char buf[64 * 1024];
+        size_t got;
+        while ((got = std::fread(buf, 1, sizeof(buf), in)) > 0) {
+            data.append(buf, got);
+        }
+        std::fclose(in);
+    }
+
+    Uint64 t0 = SDL_GetTicksNS();
+    uint64_t versionBefore = a.entries_version.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(a.entries_mutex);
+        uint32_t records = journal_replay_locked(a, data);
+        double ms = static_cast<double>(SDL_GetTicksNS() - t0) / 1e6;
+        if (records > 0) {
+            log_info("[Journal] Restored %zu player(s) and %zu past winner(s) from %s in %.1f ms",
+                a.entries.size(), j.winners.size(), path.c_str(), ms);
+        }
 
+        j.recording = true;
+        journal_compact_locked(a);
+    }
 
-static std::string to_lower(const std::string& s) {
-    std::string out = s;
-    std::transform(out.begin(), out.end(), out.begin(),
-        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
-    return out;
+    // On the web this runs after frames (and page joins) have been drawn;
+    // index-keyed labels and the cached wheel may belong to other names now
+    if (a.entries_version.load(std::memory_order_relaxed) != versionBefore) {
+        label_cache_clear();
+        wheel_texture_invalidate();
+    }
 }
 
-static bool is_stream_allowed(const std::string& nick, const std::string& channel)
-{
-    // All names here should be lowercase. Add/remove entries as needed.
-    static const char* ALLOWED[] = {
-        "cbf01",       // example allowed channel/host
-        "shoepert",
-        
-    };
+// Once per frame: write what the last frame recorded, and compact once the
+// log is mostly superseded records. Main thread only.
+static void journal_flush(AppState& a) {
+    Journal& j = g_journal;
+    if (!j.recording) return;
 
-    std::string n  = to_lower(nick);
+    if (!j.pending.empty()) {
+        if (j.file) {
+            std::fwrite(j.pending.data(), 1, j.pending.size(), j.file);
+            std::fflush(j.file);
+        }
+        j.pending.clear();
+#ifdef __EMSCRIPTEN__
+        j.sync_pending = true;
+#endif
 
-    std::string ch = channel;
-    if (!ch.empty() && ch[0] == '#') {
-        ch.erase(0, 1); // strip leading '#'
+        if (j.records > JOURNAL_COMPACT_MIN && !j.compact_failed) {
+            std::lock_guard<std::mutex> lock(a.entries_mutex);
+            if (j.records > 2 * (a.entries.size() + j.winners.size())) {
+                journal_compact_locked(a);
+            }
+        }
     }
-    ch = to_lower(ch);
 
-    for (const char* allowed : ALLOWED) {
-        if (n == allowed || ch == allowed) {
-            return true;
+#ifdef __EMSCRIPTEN__
+    // Copy the in-memory FS to IndexedDB; one sync in flight at a time
+    Uint64 now = SDL_GetTicks();
+    if (j.sync_pending && now - j.last_sync_ms >= JOURNAL_SYNC_MS) {
+        int started = EM_ASM_INT({
+            if (Module.journalSyncing) return 0;
+            Module.journalSyncing = true;
+            FS.syncfs(false, function(err) {
+                Module.journalSyncing = false;
+                if (err) console.error('journal sync failed', err);
+            });
+            return 1;
+        });
+        if (started) {
+            j.sync_pending = false;
+            j.last_sync_ms = now;
         }
     }
-    return false;
+#endif
 }
-static void add_player_if_new(const std::string& name,
-    std::vector<WheelEntry>& entries,
-    std::mutex& entries_mutex) {
-    if (name.empty()) return;
-    std::lock_guard<std::mutex> lock(entries_mutex);
-    auto it = std::find_if(entries.begin(), entries.end(),
-        [&](const WheelEntry& w) { return w.name == name; });
-    if (it == entries.end()) {
-        WheelEntry e;
-        e.name = name;
-        e.color = random_color();
-        entries.push_back(e);
-        std::cout << "[Twitch] Added player: " << name << std::endl;
+
+static void journal_close() {
+    Journal& j = g_journal;
+    if (j.file) {
+        if (!j.pending.empty()) {
+            std::fwrite(j.pending.data(), 1, j.pending.size(), j.file);
+        }
+        std::fclose(j.file);
+        j.file = nullptr;
+    }
+    j.pending.clear();
+    j.recording = false;
+}
+
+// Past winners, newest first, one "<n>. <name>" per line. F5 logs it; the
+// web build also hands it to the page through wheel_history().
+static std::string winner_history_text() {
+    const std::vector<std::string>& w = g_journal.winners;
+    std::string text;
+    for (size_t i = 0; i < w.size(); ++i) {
+        text += std::to_string(i + 1);
+        text += ". ";
+        text += w[w.size() - 1 - i];
+        text += '\n';
+    }
+    return text;
+}
+
+static void log_winner_history() {
+    const std::vector<std::string>& w = g_journal.winners;
+    if (w.empty()) {
+        log_info("[Journal] No past winners yet");
+        return;
+    }
+    log_info("[Journal] Last %zu winner(s), newest first:", w.size());
+    for (size_t i = 0; i < w.size(); ++i) {
+        log_info("[Journal]   %zu. %s", i + 1, w[w.size() - 1 - i].c_str());
     }
 }
 
@@ -480,12 +2119,80 @@ static void add_player_if_new(const std::string& name,
 // Twitch IRC helpers
 // ----------------------
 #ifndef __EMSCRIPTEN__
+// Thin portability layer over winsock / BSD sockets. Everything below this
+// uses the winsock spellings (SOCKET, INVALID_SOCKET, closesocket).
+#ifdef _WIN32
+typedef WSAPOLLFD net_pollfd;
+static constexpr int NET_SEND_FLAGS = 0;
+
+static bool net_startup() {
+    WSADATA wsaData{};
+    int err = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (err != 0) {
+        log_error("[Twitch] WSAStartup failed with error: %d", err);
+        return false;
+    }
+    return true;
+}
+static void net_cleanup() { WSACleanup(); }
+static int  net_last_error() { return WSAGetLastError(); }
+static bool net_interrupted(int err) { return err == WSAEINTR; }
+static bool net_would_block(int err) { return err == WSAEWOULDBLOCK; }
+static bool net_connect_pending(int err) { return err == WSAEWOULDBLOCK; }
+static int  net_poll(net_pollfd* fds, size_t count, int timeoutMs) {
+    return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+}
+static bool net_set_nonblocking(SOCKET s, bool on) {
+    u_long mode = on ? 1 : 0;
+    return ioctlsocket(s, FIONBIO, &mode) == 0;
+}
+static void net_no_sigpipe(SOCKET) {}
+#else
+typedef int    SOCKET;
+typedef pollfd net_pollfd;
+static constexpr SOCKET INVALID_SOCKET = -1;
+static constexpr int    SOCKET_ERROR = -1;
+// A send() on a socket the server hung up must fail with EPIPE rather than
+// kill the process. Linux takes MSG_NOSIGNAL per call; macOS and the BSDs
+// without it set SO_NOSIGPIPE on the socket instead (net_no_sigpipe).
+#ifdef MSG_NOSIGNAL
+static constexpr int    NET_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int    NET_SEND_FLAGS = 0;
+#endif
+
+static bool net_startup() { return true; }
+static void net_cleanup() {}
+static int  closesocket(SOCKET s) { return close(s); }
+static int  net_last_error() { return errno; }
+static bool net_interrupted(int err) { return err == EINTR; }
+static bool net_would_block(int err) { return err == EAGAIN || err == EWOULDBLOCK; }
+static bool net_connect_pending(int err) { return err == EINPROGRESS; }
+static int  net_poll(net_pollfd* fds, size_t count, int timeoutMs) {
+    return poll(fds, static_cast<nfds_t>(count), timeoutMs);
+}
+static bool net_set_nonblocking(SOCKET s, bool on) {
+    int flags = fcntl(s, F_GETFL, 0);
+    if (flags < 0) return false;
+    flags = on ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return fcntl(s, F_SETFL, flags) == 0;
+}
+static void net_no_sigpipe(SOCKET s) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    (void)s;
+#endif
+}
+#endif
+
 static bool send_line(SOCKET sock, const std::string& line) {
     std::string data = line + "\r\n";
     size_t total = 0;
     while (total < data.size()) {
         int sent = send(sock, data.c_str() + total,
-            static_cast<int>(data.size() - total), 0);
+            static_cast<int>(data.size() - total), NET_SEND_FLAGS);
         if (sent == SOCKET_ERROR) {
             return false;
         }
@@ -496,183 +2203,588 @@ static bool send_line(SOCKET sock, const std::string& line) {
 
 
 
-static std::string parse_username_from_irc_line(const std::string& line) {
+// ASCII case-insensitive prefix test (no lowercase copy)
+static bool starts_with_nocase(std::string_view s, std::string_view prefix) {
+    if (s.size() < prefix.size()) return false;
+    for (size_t i = 0; i < prefix.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(s[i])) !=
+            std::tolower(static_cast<unsigned char>(prefix[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// One IRC line split into views of the original text; nothing is copied.
+//   [@tags] [:nick!user@host] COMMAND [middle params] [:trailing]
+struct IrcMessage {
+    std::string_view tags;     // without the leading '@'
+    std::string_view nick;     // prefix up to '!' (empty for server lines)
+    std::string_view command;
+    std::string_view target;   // first middle param, e.g. "#channel"
+    std::string_view trailing; // text after " :"
+};
+
+static bool parse_irc_line(std::string_view line, IrcMessage& out) {
+    out = IrcMessage{};
+
+    auto next_word = [&line]() -> std::string_view {
+        size_t space = line.find(' ');
+        std::string_view word = line.substr(0, space);
+        line = (space == std::string_view::npos) ? std::string_view{} : line.substr(space + 1);
+        return word;
+    };
+
     // Handles possible IRCv3 tags that start with '@'
-    size_t idx = 0;
     if (!line.empty() && line[0] == '@') {
-        size_t space = line.find(' ');
-        if (space == std::string::npos) {
-            return {};
+        out.tags = next_word().substr(1);
+    }
+    if (!line.empty() && line[0] == ':') {
+        std::string_view prefix = next_word().substr(1);
+        size_t ex = prefix.find('!');
+        if (ex != std::string_view::npos) {
+            out.nick = prefix.substr(0, ex);
+        }
+    }
+
+    out.command = next_word();
+    if (out.command.empty()) return false;
+
+    while (!line.empty()) {
+        if (line[0] == ':') {
+            out.trailing = line.substr(1);
+            break;
+        }
+        std::string_view param = next_word();
+        if (out.target.empty()) {
+            out.target = param;
         }
-        idx = space + 1;
     }
-    if (idx < line.size() && line[idx] == ':') {
-        size_t prefix_start = idx + 1;
-        size_t ex = line.find('!', prefix_start);
-        if (ex != std::string::npos) {
-            return line.substr(prefix_start, ex - prefix_start);
+    return true;
+}
+
+// Value of one IRCv3 tag ("key=value;key=value"), empty if absent
+static std::string_view irc_tag(std::string_view tags, std::string_view key) {
+    while (!tags.empty()) {
+        size_t semi = tags.find(';');
+        std::string_view tag = tags.substr(0, semi);
+        tags = (semi == std::string_view::npos) ? std::string_view{} : tags.substr(semi + 1);
+        if (tag.size() > key.size() && tag[key.size()] == '=' &&
+            tag.substr(0, key.size()) == key) {
+            return tag.substr(key.size() + 1);
         }
     }
     return {};
 }
 
-// Handle one IRC line from Twitch
-static void handle_irc_line(const std::string& line,
+// Index of a PRIVMSG target in a.channel_stats, or NO_CHANNEL if it isn't
+// listed, so a stray target never skews another channel's counts.
+static uint8_t find_channel(const AppState& a, std::string_view target) {
+    for (size_t i = 0; i < a.channel_stats.size(); ++i) {
+        const std::string& name = a.channel_stats[i].name;
+        if (name.size() == target.size() && starts_with_nocase(target, name)) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    return NO_CHANNEL;
+}
+
+// Handle one IRC line from Twitch. Only a !join allocates (for the queue).
+static void handle_irc_line(std::string_view line,
     SOCKET sock,
-    std::vector<WheelEntry>& entries,
-    std::mutex& entries_mutex) {
+    AppState& a) {
     if (line.empty()) return;
 
+    IrcMessage msg;
+    if (!parse_irc_line(line, msg)) return;
+
     // Respond to PING to stay connected
-    if (line.rfind("PING", 0) == 0) {
-        size_t colon = line.find(':');
-        std::string payload = (colon != std::string::npos)
-            ? line.substr(colon + 1)
-            : "tmi.twitch.tv";
-        send_line(sock, "PONG :" + payload);
+    if (msg.command == "PING") {
+        std::string_view payload = !msg.trailing.empty() ? msg.trailing
+                                 : !msg.target.empty()   ? msg.target
+                                 : std::string_view("tmi.twitch.tv");
+        std::string pong = "PONG :";
+        pong.append(payload.data(), payload.size());
+        send_line(sock, pong);
         return;
     }
 
     // We only care about PRIVMSG lines
-    size_t priv = line.find("PRIVMSG");
-    if (priv == std::string::npos) {
+    if (msg.command != "PRIVMSG" || msg.nick.empty()) {
         return;
     }
 
-    std::string username = parse_username_from_irc_line(line);
+    // Queue it for the main loop, which applies join_open, dedupe and the
+    // rate limits. Never blocks: if the main loop is that far behind, the
+    // join is dropped.
+    if (starts_with_nocase(msg.trailing, "!join")) {
+        ChatCommand req;
+        req.name.assign(msg.nick.data(), msg.nick.size());
+        req.channel = find_channel(a, msg.target);
+        req.subscriber = irc_tag(msg.tags, "subscriber") == "1";
+        if (req.channel < a.channel_stats.size()) {
+            a.channel_stats[req.channel].joins.fetch_add(1, std::memory_order_relaxed);
+        }
+        queue_chat_command(a, std::move(req));
+    }
+}
+
+// Receive buffer that splits the byte stream into "\r\n"-terminated lines
+// handed out as string_views into its own storage. recv() writes straight
+// into the free tail; leftover partial lines are moved to the front once
+// per recv instead of erasing from the front once per line. The buffer
+// doubles (up to IRC_RECV_BUFFER_MAX) when reads keep filling it.
+static constexpr size_t IRC_RECV_BUFFER_MIN = 4 * 1024;
+static constexpr size_t IRC_RECV_BUFFER_MAX = 256 * 1024;
+
+struct IrcLineBuffer {
+    std::vector<char> data = std::vector<char>(IRC_RECV_BUFFER_MIN);
+    size_t begin = 0;        // first unconsumed byte
+    size_t end = 0;          // one past the last received byte
+    bool   discarding = false; // dropping an over-long line until the next "\r\n"
+
+    // Make room for the next recv() and return where it should write
+    char* write_ptr() {
+        if (begin > 0) {
+            std::memmove(data.data(), data.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == data.size()) {
+            if (data.size() < IRC_RECV_BUFFER_MAX) {
+                data.resize(data.size() * 2);
+            }
+            else {
+                // A single line filled the whole buffer; throw it away, but
+                // keep a trailing '\r' so a "\r\n" split across reads
+                // still ends it
+                bool keepCr = data[end - 1] == '\r';
+                if (keepCr) data[0] = '\r';
+                end = keepCr ? 1 : 0;
+                discarding = true;
+            }
+        }
+        return data.data() + end;
+    }
+
+    size_t write_space() const { return data.size() - end; }
 
-    // Grab the message text after "PRIVMSG <channel> :"
-    size_t colonAfterPriv = line.find(" :", priv);
-    if (colonAfterPriv == std::string::npos) {
-        return;
+    // Record `bytes` written at write_ptr(). A read that fills all the free
+    // space means the socket had more waiting, so grow for the next one.
+    void commit(size_t bytes, size_t requested) {
+        end += bytes;
+        if (bytes == requested && data.size() < IRC_RECV_BUFFER_MAX) {
+            data.resize(data.size() * 2);
+        }
     }
-    std::string message = line.substr(colonAfterPriv + 2);
-    std::string lower = to_lower(message);
 
-    if (lower.rfind("!join", 0) == 0) {
-        if (app.join_open.load()) {
-            add_player_if_new(username, entries, entries_mutex);
-        } else {
-            std::cout << "[Twitch] Ignoring !join from " << username
-                      << " (wheel closed)\n";
+    // Next complete line (without "\r\n"); valid until the next write_ptr()
+    bool next_line(std::string_view& line) {
+        for (;;) {
+            std::string_view pending(data.data() + begin, end - begin);
+            size_t pos = pending.find("\r\n");
+            if (pos == std::string_view::npos) return false;
+
+            begin += pos + 2;
+            if (discarding) {
+                discarding = false;
+                continue;
+            }
+            line = pending.substr(0, pos);
+            return true;
         }
     }
+};
+
+
+// Reconnect delay: doubles after every failed session, capped, and resets
+// once a session gets as far as the server's welcome (001).
+static constexpr int IRC_BACKOFF_MIN_MS = 1000;
+static constexpr int IRC_BACKOFF_MAX_MS = 30000;
+static constexpr int IRC_CONNECT_TIMEOUT_MS = 10000;
+// Twitch PINGs roughly every 5 minutes; longer silence means a dead link.
+static constexpr int IRC_IDLE_TIMEOUT_MS = 6 * 60 * 1000;
+// IRC caps a line at 512 bytes including "\r\n"
+static constexpr size_t IRC_MAX_LINE = 510;
+
+// Loopback UDP socket the chat thread polls next to the IRC socket.
+// twitch_chat_wake() sends it one datagram, so a thread blocked in poll()
+// (or in a reconnect backoff) returns at once instead of waiting out a
+// timeout. Owned by main(): opened before the thread starts and closed
+// after it is joined.
+struct IrcWaker {
+    SOCKET      sock = INVALID_SOCKET;
+    sockaddr_in addr{};
+};
+
+static bool irc_waker_open(IrcWaker& w) {
+    SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (s == INVALID_SOCKET) return false;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0; // any free port
+    socklen_t len = sizeof(addr);
+    if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+        getsockname(s, reinterpret_cast<sockaddr*>(&addr), &len) == SOCKET_ERROR ||
+        !net_set_nonblocking(s, true)) {
+        closesocket(s);
+        return false;
+    }
+    w.sock = s;
+    w.addr = addr;
+    return true;
 }
 
+static void irc_waker_close(IrcWaker& w) {
+    if (w.sock != INVALID_SOCKET) {
+        closesocket(w.sock);
+        w.sock = INVALID_SOCKET;
+    }
+}
 
-// connect to Twitch IRC and watch for "!join"
-static void twitch_chat_thread(TwitchConfig cfg,
-    std::atomic<bool>& running,
-    std::vector<WheelEntry>& entries,
-    std::mutex& entries_mutex) {
-    if (cfg.oauth.empty() || cfg.nick.empty() || cfg.channel.empty()) {
-        std::cerr << "[Twitch] Config not set; skipping chat integration.\n";
-        return;
+// Any thread. Safe to call more than once.
+static void twitch_chat_wake(const IrcWaker& w) {
+    if (w.sock == INVALID_SOCKET) return;
+    char byte = 1;
+    sendto(w.sock, &byte, 1, 0,
+        reinterpret_cast<const sockaddr*>(&w.addr), sizeof(w.addr));
+}
+
+enum class NetWait { Ready, Timeout, Woken, Error };
+
+// Block until `sock` is ready for `events`, the waker fires, or timeoutMs
+// passes. Pass INVALID_SOCKET to just sleep (interruptibly).
+static NetWait irc_wait(SOCKET sock, short events, const IrcWaker& waker, int timeoutMs) {
+    net_pollfd fds[2]{};
+    size_t count = 0;
+    if (sock != INVALID_SOCKET) {
+        fds[count].fd = sock;
+        fds[count].events = events;
+        ++count;
     }
+    fds[count].fd = waker.sock;
+    fds[count].events = POLLIN;
+    ++count;
 
-    WSADATA wsaData{};
-    int wsaErr = WSAStartup(MAKEWORD(2, 2), &wsaData);
-    if (wsaErr != 0) {
-        std::cerr << "[Twitch] WSAStartup failed with error: "
-            << wsaErr << "\n";
-        return;
+    int res = net_poll(fds, count, timeoutMs);
+    if (res < 0) {
+        return net_interrupted(net_last_error()) ? NetWait::Timeout : NetWait::Error;
+    }
+    if (res == 0) {
+        return NetWait::Timeout;
     }
+    if (fds[count - 1].revents != 0) {
+        char buf[64];
+        while (recv(waker.sock, buf, sizeof(buf), 0) > 0) {}
+        return NetWait::Woken;
+    }
+    // POLLERR / POLLHUP count as ready too; the following recv() reports them
+    return NetWait::Ready;
+}
 
+// Resolve and connect. The connect itself is non-blocking and waited on
+// with irc_wait(), so shutdown can cut it short. Name lookup still blocks.
+static SOCKET irc_connect(const char* host, const char* port,
+    const std::atomic<bool>& running, const IrcWaker& waker) {
     addrinfo hints{};
     hints.ai_family = AF_UNSPEC;
     hints.ai_socktype = SOCK_STREAM;
     hints.ai_protocol = IPPROTO_TCP;
 
     addrinfo* result = nullptr;
-    int res = getaddrinfo("irc.chat.twitch.tv", "6667", &hints, &result);
+    int res = getaddrinfo(host, port, &hints, &result);
     if (res != 0 || !result) {
-        std::cerr << "[Twitch] getaddrinfo failed.\n";
-        WSACleanup();
-        return;
+        log_error("[Twitch] getaddrinfo failed.");
+        return INVALID_SOCKET;
     }
 
     SOCKET sock = INVALID_SOCKET;
-    for (addrinfo* ptr = result; ptr != nullptr; ptr = ptr->ai_next) {
+    for (addrinfo* ptr = result; ptr != nullptr && running.load(); ptr = ptr->ai_next) {
         sock = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
         if (sock == INVALID_SOCKET) continue;
-        if (connect(sock, ptr->ai_addr, static_cast<int>(ptr->ai_addrlen)) == SOCKET_ERROR) {
-            closesocket(sock);
-            sock = INVALID_SOCKET;
-            continue;
+        net_no_sigpipe(sock);
+
+        bool connected = false;
+        if (net_set_nonblocking(sock, true)) {
+            if (connect(sock, ptr->ai_addr, static_cast<int>(ptr->ai_addrlen)) == 0) {
+                connected = true;
+            }
+            else if (net_connect_pending(net_last_error()) &&
+                irc_wait(sock, POLLOUT, waker, IRC_CONNECT_TIMEOUT_MS) == NetWait::Ready) {
+                int soErr = 0;
+                socklen_t len = sizeof(soErr);
+                connected =
+                    getsockopt(sock, SOL_SOCKET, SO_ERROR,
+                        reinterpret_cast<char*>(&soErr), &len) == 0 && soErr == 0;
+            }
         }
-        break;
+
+        // Reads only happen after poll() says so; plain blocking I/O from here
+        if (connected && net_set_nonblocking(sock, false)) {
+            break;
+        }
+        closesocket(sock);
+        sock = INVALID_SOCKET;
     }
     freeaddrinfo(result);
+    return sock;
+}
 
-    if (sock == INVALID_SOCKET) {
-        std::cerr << "[Twitch] Could not connect to IRC.\n";
-        WSACleanup();
-        return;
+// JOIN every channel, packing as many as fit into each line ("JOIN #a,#b").
+static bool send_join(SOCKET sock, const std::vector<std::string>& channels) {
+    std::string line;
+    for (const std::string& ch : channels) {
+        if (!line.empty() && line.size() + 1 + ch.size() > IRC_MAX_LINE) {
+            if (!send_line(sock, line)) return false;
+            line.clear();
+        }
+        line += line.empty() ? "JOIN " : ",";
+        line += ch;
     }
+    return line.empty() || send_line(sock, line);
+}
 
-    std::cout << "[Twitch] Connected, logging in...\n";
-
+// One connected session: log in, join every configured channel, then pump lines through
+// handle_irc_line until the server hangs up, the link goes quiet or
+// shutdown is requested. Returns true if the server accepted the login.
+static bool irc_run_session(SOCKET sock,
+    const TwitchConfig& cfg,
+    const std::atomic<bool>& running,
+    const IrcWaker& waker,
+    AppState& a) {
     // cfg.oauth should already include "oauth:" prefix if you set TWITCH_OAUTH that way.
-    if (!send_line(sock, "PASS " + cfg.oauth) ||
+    // Tags carry the subscriber flag used for !join tickets.
+    if (!send_line(sock, "CAP REQ :twitch.tv/tags") ||
+        !send_line(sock, "PASS " + cfg.oauth) ||
         !send_line(sock, "NICK " + cfg.nick) ||
-        !send_line(sock, "JOIN " + cfg.channel)) {
-        std::cerr << "[Twitch] Failed to send login messages.\n";
-        closesocket(sock);
-        WSACleanup();
-        return;
-    }
-
-    // Make recv() time out periodically so we can notice 'running == false'
-    DWORD timeoutMs = 200; // 0.2 seconds
-    if (setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO,
-        reinterpret_cast<const char*>(&timeoutMs),
-        sizeof(timeoutMs)) == SOCKET_ERROR) {
-        std::cerr << "[Twitch] setsockopt(SO_RCVTIMEO) failed: "
-            << WSAGetLastError() << "\n";
-        // Not fatal; we can continue, but shutdown may be slower
+        !send_join(sock, cfg.channels)) {
+        log_error("[Twitch] Failed to send login messages.");
+        return false;
     }
 
-    char buffer[1024];
-    std::string recvBuffer;
+    IrcLineBuffer recvBuffer;
+    bool welcomed = false;
 
     while (running.load()) {
-        int bytes = recv(sock, buffer, sizeof(buffer) - 1, 0);
+        NetWait wait = irc_wait(sock, POLLIN, waker, IRC_IDLE_TIMEOUT_MS);
+        if (wait == NetWait::Woken) {
+            continue; // re-check 'running'
+        }
+        if (wait == NetWait::Timeout) {
+            log_warn("[Twitch] No traffic for %d s; reconnecting.", IRC_IDLE_TIMEOUT_MS / 1000);
+            break;
+        }
+        if (wait == NetWait::Error) {
+            log_error("[Twitch] poll failed with error: %d", net_last_error());
+            break;
+        }
+
+        char* dst = recvBuffer.write_ptr();
+        size_t space = recvBuffer.write_space();
+        int bytes = recv(sock, dst, static_cast<int>(space), 0);
 
         if (bytes == SOCKET_ERROR) {
-            int err = WSAGetLastError();
-            if (err == WSAETIMEDOUT) {
-                // Normal: timeout so we can re-check 'running'
+            int err = net_last_error();
+            if (net_interrupted(err) || net_would_block(err)) {
                 continue;
             }
-            std::cerr << "[Twitch] recv failed with error: " << err << "\n";
+            log_error("[Twitch] recv failed with error: %d", err);
             break;
         }
 
         if (bytes == 0) {
-            std::cerr << "[Twitch] Disconnected.\n";
+            log_warn("[Twitch] Disconnected.");
             break;
         }
 
-        buffer[bytes] = '\0';
-        recvBuffer.append(buffer);
+        recvBuffer.commit(static_cast<size_t>(bytes), space);
 
-        size_t pos;
-        while ((pos = recvBuffer.find("\r\n")) != std::string::npos) {
-            std::string line = recvBuffer.substr(0, pos);
-            recvBuffer.erase(0, pos + 2);
+        std::string_view line;
+        while (recvBuffer.next_line(line)) {
+            // Off unless log_level=debug in twitch.cfg
+            log_debug("[Twitch RAW] %.*s", static_cast<int>(line.size()), line.data());
 
-            std::cout << "[Twitch RAW] " << line << "\n";
+            if (!welcomed) {
+                IrcMessage msg;
+                welcomed = parse_irc_line(line, msg) && msg.command == "001";
+            }
+            handle_irc_line(line, sock, a);
+        }
+    }
+    return welcomed;
+}
+
+// connect to Twitch IRC and watch for "!join". Reconnects with backoff
+// until 'running' is cleared and twitch_chat_wake() is called.
+static void twitch_chat_thread(TwitchConfig cfg,
+    std::atomic<bool>& running,
+    const IrcWaker& waker,
+    AppState& a) {
+    if (cfg.oauth.empty() || cfg.nick.empty() || cfg.channels.empty()) {
+        log_warn("[Twitch] Config not set; skipping chat integration.");
+        return;
+    }
 
-            handle_irc_line(line, sock, entries, entries_mutex);
+    int backoffMs = IRC_BACKOFF_MIN_MS;
 
+    while (running.load()) {
+        SOCKET sock = irc_connect("irc.chat.twitch.tv", "6667", running, waker);
+        if (sock != INVALID_SOCKET) {
+            log_info("[Twitch] Connected, logging in...");
+            if (irc_run_session(sock, cfg, running, waker, a)) {
+                backoffMs = IRC_BACKOFF_MIN_MS;
+            }
+            closesocket(sock);
         }
+        else if (running.load()) {
+            log_error("[Twitch] Could not connect to IRC.");
+        }
+
+        if (!running.load()) break;
+
+        log_info("[Twitch] Reconnecting in %d s...", backoffMs / 1000);
+        irc_wait(INVALID_SOCKET, 0, waker, backoffMs);
+        backoffMs = std::min(backoffMs * 2, IRC_BACKOFF_MAX_MS);
     }
 
-    closesocket(sock);
-    WSACleanup();
-    std::cout << "[Twitch] Thread exiting.\n";
+    log_info("[Twitch] Thread exiting.");
 }
 #endif
+
+
+// ----------------------
+// Spins
+// ----------------------
+
+static int pointer_slice_index(float current_angle, const EntryStore& entries);
+
+static TTF_Font* winner_banner_font(const AppState& a) {
+    return a.status_font ? a.status_font : a.font;
+}
+
+// Every spin is a pure function of (seed, start angle, entries): the seed
+// gives the launch speed and friction, the closed-form physics the stop
+// angle, and the tickets the winner. Those three are published when the
+// spin starts ("[Wheel] Spin seed=..." in the log, wheel_spin_record() on
+// the web), so anyone can re-run the draw, and a second overlay can play
+// the same spin from a few bytes with wheel_spin_seeded().
+static uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1), exact in a float
+static float splitmix_unit(uint64_t& state) {
+    return static_cast<float>(splitmix64(state) >> 40) * (1.0f / 16777216.0f);
+}
+
+// FNV-1a over each entry's name and tickets, in wheel order. Colors are
+// left out; they don't change who wins.
+static uint64_t entries_hash(const EntryStore& entries) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto mix = [&h](const void* data, size_t len) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < len; ++i) {
+            h = (h ^ p[i]) * 0x100000001B3ull;
+        }
+    };
+    for (size_t i = 0; i < entries.size(); ++i) {
+        std::string_view name = entries.name(i);
+        uint32_t len = static_cast<uint32_t>(name.size());
+        uint32_t weight = entries.weights[i];
+        unsigned char buf[8];
+        for (int k = 0; k < 4; ++k) {
+            buf[k]     = static_cast<unsigned char>(len >> (8 * k));     // little-endian
+            buf[4 + k] = static_cast<unsigned char>(weight >> (8 * k));  // on every host
+        }
+        mix(buf, 4);
+        mix(name.data(), name.size());
+        mix(buf + 4, 4);
+    }
+    return h;
+}
+
+// With "spin_seed=" in twitch.cfg every seed in the session follows from
+// it, so a whole stream's draws can be re-run from the config alone.
+static uint64_t next_spin_seed(AppState& a) {
+    if (a.seeded_spins) {
+        return splitmix64(a.spin_seed_state);
+    }
+    uint64_t hi = global_rng()();
+    return (hi << 32) | global_rng()();
+}
+
+// "seed=<16 hex> hash=<16 hex> angle=<float> entries=<n>"; the angle's 9
+// significant digits round-trip a float exactly.
+static std::string spin_record(const AppState& a) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "seed=%016llx hash=%016llx angle=%.9g entries=%zu",
+        static_cast<unsigned long long>(a.spin_seed),
+        static_cast<unsigned long long>(a.spin_entries_hash),
+        static_cast<double>(a.spin_start_angle),
+        a.spin_entry_count);
+    return buf;
+}
+
+// Start a spin from the current angle. The seed picks a launch speed and
+// constant deceleration, then we solve for the stop angle (v0^2 / 2a past
+// the start) and the winner, which is known from this moment on. The
+// banner label is rasterized now so the reveal doesn't stall on TTF.
+// Caller must hold entries_mutex.
+static void start_spin_seeded_locked(AppState& a, uint64_t seed) {
+    uint64_t state = seed;
+    float speed = 10.0f + 3.0f * splitmix_unit(state);      // 10 .. 13 rad/s
+    float friction = 1.8f + 3.8f * splitmix_unit(state);    // 1.8 .. 5.6 rad/s^2
+
+    a.spin_seed = seed;
+    a.spin_entries_hash = entries_hash(a.entries);
+    a.spin_entry_count = a.entries.size();
+    a.spin_friction = friction;
+    a.angular_velocity = speed;
+
+    a.spinning = true;
+    a.winner_index = -1;
+    a.winner_flash_remaining = 0.0f;
+    a.winner_flash_elapsed = 0.0f;
+
+    const double TWO_PI = 2.0 * 3.14159265358979323846;
+    double v0 = a.angular_velocity;
+    double decel = a.spin_friction;
+    double finalAngle = std::fmod(a.current_angle + v0 * v0 / (2.0 * decel), TWO_PI);
+    if (finalAngle < 0.0) finalAngle += TWO_PI;
+
+    a.spin_time = 0.0f;
+    a.spin_duration = static_cast<float>(v0 / decel);
+    a.spin_start_angle = a.current_angle;
+    a.spin_initial_velocity = a.angular_velocity;
+    a.spin_final_angle = static_cast<float>(finalAngle);
+    a.spin_entries_version = a.entries_version.load(std::memory_order_relaxed);
+
+    a.spin_winner = pointer_slice_index(a.spin_final_angle, a.entries);
+    if (a.spin_winner >= 0 && a.renderer) {
+        get_label_texture(a.renderer, winner_banner_font(a),
+            a.entries.name(a.spin_winner), SDL_Color{ 255, 255, 255, 255 });
+    }
+
+    log_info("[Wheel] Spin %s", spin_record(a).c_str());
+}
+
+// Caller must hold entries_mutex.
+static void start_spin_locked(AppState& a) {
+    start_spin_seeded_locked(a, next_spin_seed(a));
+}
+
+// Angle at spin_time along the solved trajectory (not wrapped).
+static float spin_angle_at(const AppState& a, float t) {
+    double v0 = a.spin_initial_velocity;
+    double decel = a.spin_friction;
+    return static_cast<float>(a.spin_start_angle + v0 * t - 0.5 * decel * t * t);
+}
+
 static void handle_spin_or_reset(AppState& app, const TwitchConfig& cfg)
 {
     bool didReset = false;
@@ -697,99 +2809,275 @@ static void handle_spin_or_reset(AppState& app, const TwitchConfig& cfg)
             app.angular_velocity = 0.0f;
 
             // Clear all players from the wheel so chat can !join again
-            app.entries.clear();
+            clear_entries_locked(app);
 
             // Return to CLOSED state
             app.join_open.store(false);
 
 
             didReset = true;
-            std::cout << "[Wheel] Reset for next round.\n";
+            log_info("[Wheel] Reset for next round.");
         }
         // Otherwise, if not spinning and we have players, start a new spin
         else if (app.entries.size() >= 2 && !app.spinning && !app.join_open.load()) {
-            app.spinning = true;
-            app.winner_index = -1;
-            app.winner_flash_remaining = 0.0f;
-            app.winner_flash_elapsed = 0.0f;
+            start_spin_locked(app);
+
+            log_info("[Wheel] Spin started.");
+            log_channel_stats(app);
+        }
+    } // mutex unlocked here
+
+    // Old names won't be drawn again; drop their label textures
+    if (didReset) {
+        label_cache_clear();
+    }
+
+    // After reset, automatically add the channel owner as if they had joined
+    if (didReset && !cfg.nick.empty()) {
+        add_player_if_new(app, cfg.nick);
+    }
+}
+
+
+static void set_join_open(AppState& a, bool open)
+{
+    bool wasOpen = a.join_open.load(std::memory_order_relaxed);
+    if (wasOpen == open) return;
+
+    a.join_open.store(open, std::memory_order_relaxed);
+
+    if (open) {
+        timer_reset(a, TIMER_START_SECONDS); // 60
+        timer_start(a);
+    }
+    else {
+        timer_stop(a);
+    }
+}
+
+
+// ----------------------
+// Chat commands
+// ----------------------
 
-            std::uniform_real_distribution<float> spinSpeed(10.0f, 13.0f);
-            std::uniform_real_distribution<float> spinFriction(1.8f, 5.6f);
+// Every chat command passes through here on the main thread, once per
+// frame. A command is dropped if the same user sent the same command
+// within command_window_ms, if that user is out of tokens
+// (USER_COMMAND_BURST, refilled at user_commands_per_min) or if everyone
+// together is over commands_per_sec. What survives a frame is applied in
+// one locked pass: all joins, then at most one spin or reset, so a wave
+// of "!spin" is one state transition however many copies arrive.
+static constexpr float    USER_COMMAND_BURST = 3.0f;
+static constexpr uint64_t CHAT_PRUNE_INTERVAL_MS = 10000;
+
+struct TokenBucket {
+    float    tokens = -1.0f;  // < 0 until first use, then starts full
+    uint64_t last_ms = 0;
+
+    bool take(uint64_t now_ms, float per_ms, float burst) {
+        if (tokens < 0.0f) {
+            tokens = burst;
+        }
+        else {
+            tokens = std::min(burst, tokens + static_cast<float>(now_ms - last_ms) * per_ms);
+        }
+        last_ms = now_ms;
+        if (tokens < 1.0f) return false;
+        tokens -= 1.0f;
+        return true;
+    }
+};
+
+struct ChatUser {
+    TokenBucket bucket;
+    uint64_t    last_accepted_ms[COMMAND_KIND_COUNT] = {};
+    uint8_t     accepted = 0;     // bit per CommandKind with a last_accepted_ms
+};
+
+struct ChatDispatcher {
+    std::unordered_map<std::string, ChatUser> users;  // fold_case(name) -> limits
+    TokenBucket global;
+    std::string key;                 // scratch for fold_case_into
+    std::vector<ChatCommand> joins;  // accepted this frame; keeps its capacity
+    uint64_t last_prune_ms = 0;
+    uint32_t deduped = 0;            // counted since the last log line
+    uint32_t throttled = 0;
+};
+
+static ChatDispatcher g_chat;
+
+// Dedupe and rate limits for one command; true if it should be applied.
+static bool chat_accept(ChatDispatcher& d, const AppState& a,
+    const ChatCommand& cmd, uint64_t now_ms)
+{
+    fold_case_into(d.key, cmd.name);
+    ChatUser& user = d.users[d.key];
+
+    const int kind = static_cast<int>(cmd.kind);
+    const uint8_t bit = static_cast<uint8_t>(1u << kind);
+    if ((user.accepted & bit) &&
+        now_ms - user.last_accepted_ms[kind] < a.command_window_ms) {
+        ++d.deduped;
+        return false;
+    }
+
+    float userRate = static_cast<float>(a.user_commands_per_min) / 60000.0f;
+    if (a.user_commands_per_min > 0 &&
+        !user.bucket.take(now_ms, userRate, USER_COMMAND_BURST)) {
+        ++d.throttled;
+        return false;
+    }
+    if (a.commands_per_sec > 0) {
+        float globalRate = static_cast<float>(a.commands_per_sec) / 1000.0f;
+        if (!d.global.take(now_ms, globalRate, static_cast<float>(COMMAND_QUEUE_CAPACITY))) {
+            ++d.throttled;
+            return false;
+        }
+    }
 
-            app.spin_friction = spinFriction(global_rng());
-            app.angular_velocity = spinSpeed(global_rng());
+    user.accepted |= bit;
+    user.last_accepted_ms[kind] = now_ms;
+    return true;
+}
 
-            std::cout << "[Wheel] Spin started.\n";
+// Forget users whose limits have fully recovered; they'd start over the
+// same way as a new user, so nothing is lost.
+static void chat_prune(ChatDispatcher& d, const AppState& a, uint64_t now_ms) {
+    if (now_ms - d.last_prune_ms < CHAT_PRUNE_INTERVAL_MS) return;
+    d.last_prune_ms = now_ms;
+
+    uint64_t refillMs = a.user_commands_per_min > 0
+        ? static_cast<uint64_t>(USER_COMMAND_BURST * 60000.0f / a.user_commands_per_min)
+        : 0;
+    uint64_t idleMs = std::max<uint64_t>(refillMs, a.command_window_ms);
+    for (auto it = d.users.begin(); it != d.users.end();) {
+        const ChatUser& user = it->second;
+        uint64_t last = user.bucket.last_ms;
+        for (int k = 0; k < COMMAND_KIND_COUNT; ++k) {
+            if (user.accepted & (1u << k)) last = std::max(last, user.last_accepted_ms[k]);
         }
-    } // mutex unlocked here
-
-    // After reset, automatically add the channel owner as if they had joined
-    if (didReset && !cfg.nick.empty()) {
-        add_player_if_new(cfg.nick, app.entries, app.entries_mutex);
+        if (now_ms - last >= idleMs) it = d.users.erase(it);
+        else ++it;
     }
 }
 
+// "!spin" from chat: only while closed, with at least two players.
+// Caller must hold entries_mutex.
+static void chat_spin_locked(AppState& a) {
+    if (a.entries.size() < 2 || a.spinning) return;
+    if (a.join_open.load()) return; // cannot spin while OPEN
+    start_spin_locked(a);
+    log_info("[Wheel] Spin started.");
+    log_channel_stats(a);
+}
 
-static void set_join_open(AppState& a, bool open)
-{
-    bool wasOpen = a.join_open.load(std::memory_order_relaxed);
-    if (wasOpen == open) return;
+// "!reset" from chat: clear the wheel and winner, close joins and re-add
+// the channel owner.
+static void chat_reset(AppState& a) {
+    {
+        std::lock_guard<std::mutex> lock(a.entries_mutex);
+        clear_entries_locked(a);
+        a.join_open.store(false); // CLOSED
+        a.spinning = false;
+        a.angular_velocity = 0.0f;
+        a.winner_index = -1;
+        a.celebration_active = false;
+        a.celebration_time = 0.0f;
+        a.celebration_name.clear();
+    }
 
-    a.join_open.store(open, std::memory_order_relaxed);
+    label_cache_clear();
 
-    if (open) {
-        timer_reset(a, TIMER_START_SECONDS); // 60
-        timer_start(a);
-    }
-    else {
-        timer_stop(a);
+    if (!g_twitch_cfg.nick.empty()) {
+        add_player_if_new(a, g_twitch_cfg.nick);
     }
+    log_info("[Wheel] Reset from chat.");
 }
 
+// Apply every command queued since the last frame. Main thread only.
+static void dispatch_chat_commands(AppState& a) {
+    ChatDispatcher& d = g_chat;
+    const uint64_t now = SDL_GetTicks();
+    chat_prune(d, a, now);
 
-// ----------------------
-// SDL text rendering
-// ----------------------
+    uint32_t dropped = a.command_queue_dropped.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        log_warn("[Twitch] Command queue full; dropped %u command(s)", dropped);
+    }
 
-static void render_text_centered(SDL_Renderer* renderer,
-    TTF_Font* font,
-    const std::string& text,
-    SDL_Color color,
-    float x,
-    float y) {
-    if (!renderer || !font) return;
-    if (text.empty()) return;
+    ChatCommand cmd;
+    if (!a.command_queue.pop(cmd)) return;
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), 0, color);
-    if (!surface) {
-        std::cerr << "TTF_RenderText_Blended failed: " << SDL_GetError() << "\n";
-        return;
+    d.joins.clear();
+    bool spin = false;
+    bool reset = false;
+    do {
+        if (!chat_accept(d, a, cmd, now)) continue;
+        if (cmd.kind == CommandKind::Join) {
+            d.joins.push_back(std::move(cmd));
+        }
+        else if (!spin && !reset) {
+            // The first spin or reset of the frame wins; later ones coalesce
+            (cmd.kind == CommandKind::Spin ? spin : reset) = true;
+        }
+    } while (a.command_queue.pop(cmd));
+
+    uint32_t added = 0;
+    uint32_t bonus = 0;
+    uint32_t ignored = 0;
+    if (!d.joins.empty() || spin) {
+        std::lock_guard<std::mutex> lock(a.entries_mutex);
+        bool open = a.join_open.load();
+        for (const ChatCommand& join : d.joins) {
+            // The channel owner may always take the first slot
+            if (!open && !(a.entries.empty() && join.name == g_twitch_cfg.nick)) {
+                ++ignored;
+                continue;
+            }
+            JoinResult result = join_player_locked(a, join.name, join.subscriber);
+            if (result == JoinResult::Added) {
+                ++added;
+                if (join.channel < a.channel_stats.size()) {
+                    a.channel_stats[join.channel].added.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            else if (result == JoinResult::Bonus) {
+                ++bonus;
+            }
+        }
+        if (spin) {
+            chat_spin_locked(a);
+        }
     }
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "SDL_CreateTextureFromSurface failed: " << SDL_GetError() << "\n";
-        SDL_DestroySurface(surface);
-        return;
+    if (reset) {
+        chat_reset(a);
     }
 
-    SDL_FRect dst{};
-    dst.w = static_cast<float>(surface->w);
-    dst.h = static_cast<float>(surface->h);
-    dst.x = x - dst.w / 2.0f;
-    dst.y = y - dst.h / 2.0f;
+    if (added > 0) {
+        log_info("[Twitch] Added %u player(s)", added);
+    }
+    if (bonus > 0) {
+        log_info("[Twitch] %u repeat !join(s) earned a ticket", bonus);
+    }
+    if (ignored > 0) {
+        log_info("[Twitch] Ignoring %u !join(s) (wheel closed)", ignored);
+    }
+    if (d.deduped > 0 || d.throttled > 0) {
+        log_debug("[Twitch] Dropped %u repeated and %u rate-limited command(s)",
+            d.deduped, d.throttled);
+        d.deduped = 0;
+        d.throttled = 0;
+    }
+}
 
-    SDL_DestroySurface(surface);
 
-    SDL_RenderTexture(renderer, texture, nullptr, &dst);
-    SDL_DestroyTexture(texture);
-}
+// ----------------------
+// SDL text rendering
+// ----------------------
 
 // Radial, rotated, and width-scaled label rendering
-static void render_text_radial(SDL_Renderer* renderer,
-    TTF_Font* font,
-    const std::string& text,
-    SDL_Color color,
+static void render_label_radial(SDL_Renderer* renderer,
+    const LabelTexture* label,
     float cx,
     float cy,
     float radius,
@@ -798,20 +3086,12 @@ static void render_text_radial(SDL_Renderer* renderer,
     float maxRadialSpan)
 
 {
-    if (!renderer || !font) return;
-    if (text.empty()) return;
+    if (!renderer || !label) return;
 
     const float RAD_TO_DEG = 180.0f / 3.14159265358979323846f;
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), 0, color);
-    if (!surface) {
-        std::cerr << "TTF_RenderText_Blended (radial) failed: "
-            << SDL_GetError() << "\n";
-        return;
-    }
-
-    float srcW = static_cast<float>(surface->w);
-    float srcH = static_cast<float>(surface->h);
+    float srcW = label->w;
+    float srcH = label->h;
 
     // Start at full size; only scale down if necessary
     float scaleAcross = 1.0f;
@@ -829,19 +3109,9 @@ static void render_text_radial(SDL_Renderer* renderer,
     // Small padding so it doesn't feel tight against boundaries.
     scale *= 0.95f;
 
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "SDL_CreateTextureFromSurface (radial) failed: "
-            << SDL_GetError() << "\n";
-        SDL_DestroySurface(surface);
-        return;
-    }
-
     SDL_FRect dst{};
     dst.w = srcW * scale;
     dst.h = srcH * scale;
-    SDL_DestroySurface(surface); // texture now owns the pixels
 
     float dx = std::cos(angle);
     float dy = std::sin(angle);
@@ -859,17 +3129,160 @@ static void render_text_radial(SDL_Renderer* renderer,
     // Rotate with the slice so names are "painted" on the wheel
     double rotationDeg = angle * RAD_TO_DEG + 180.0;
 
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderTextureRotated(renderer,
-        texture,
+        label->texture,
         nullptr,
         &dst,
         rotationDeg,
         &pivot,
         SDL_FLIP_NONE);
+}
 
-    SDL_DestroyTexture(texture);
+static void render_text_radial(SDL_Renderer* renderer,
+    TTF_Font* font,
+    std::string_view text,
+    SDL_Color color,
+    float cx,
+    float cy,
+    float radius,
+    float angle,
+    float maxTangentSpan,
+    float maxRadialSpan)
+{
+    render_label_radial(renderer, get_label_texture(renderer, font, text, color),
+        cx, cy, radius, angle, maxTangentSpan, maxRadialSpan);
+}
+
+// ----------------------
+// Worker pool
+// ----------------------
+
+// A few threads that split per-slice work (rim points, slice fans) for
+// very large wheels. parallel_for() hands out chunks of [0, count) and
+// the calling thread takes chunks too; each chunk writes its own range of
+// a buffer sized up front, so there is nothing to merge afterwards.
+// Builds without threads (the default web build) run the range inline.
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define WHEEL_WORKER_POOL 1
+#endif
+
+static constexpr int    MAX_WORKER_THREADS = 7;     // plus the calling thread
+static constexpr size_t PARALLEL_MIN_ITEMS = 1024;  // smaller jobs run inline
+static constexpr size_t PARALLEL_MIN_CHUNK = 256;
+
+using RangeFn = void (*)(const void* ctx, size_t begin, size_t end);
+
+struct WorkerPool {
+    std::vector<std::thread> threads;
+    std::mutex               mutex;
+    std::condition_variable  wake;     // a new job or stopping
+    std::condition_variable  done;     // busy dropped to 0
+    RangeFn                  fn = nullptr;
+    const void*              ctx = nullptr;
+    size_t                   count = 0;
+    size_t                   chunk = 0;
+    std::atomic<size_t>      next{ 0 };
+    uint64_t                 generation = 0;
+    int                      busy = 0; // workers still on this generation
+    bool                     stopping = false;
+};
+
+static WorkerPool g_workers;
+
+static void worker_run_chunks(WorkerPool& p) {
+    for (;;) {
+        size_t begin = p.next.fetch_add(p.chunk, std::memory_order_relaxed);
+        if (begin >= p.count) return;
+        p.fn(p.ctx, begin, std::min(p.count, begin + p.chunk));
+    }
+}
+
+#ifdef WHEEL_WORKER_POOL
+static void worker_main(WorkerPool& p) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(p.mutex);
+    for (;;) {
+        p.wake.wait(lock, [&] { return p.stopping || p.generation != seen; });
+        if (p.stopping) return;
+        seen = p.generation;
+
+        lock.unlock();
+        worker_run_chunks(p);
+        lock.lock();
+
+        if (--p.busy == 0) {
+            p.done.notify_one();
+        }
+    }
+}
+#endif
+
+static void workers_start() {
+#ifdef WHEEL_WORKER_POOL
+    WorkerPool& p = g_workers;
+    if (!p.threads.empty()) return;
+    unsigned hw = std::thread::hardware_concurrency();
+    int count = std::min<int>(MAX_WORKER_THREADS, hw > 1 ? static_cast<int>(hw) - 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        p.threads.emplace_back(worker_main, std::ref(p));
+    }
+    if (count > 0) {
+        log_debug("[Wheel] %d geometry worker thread(s)", count);
+    }
+#endif
+}
+
+static void workers_stop() {
+#ifdef WHEEL_WORKER_POOL
+    WorkerPool& p = g_workers;
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.stopping = true;
+    }
+    p.wake.notify_all();
+    for (std::thread& t : p.threads) {
+        t.join();
+    }
+    p.threads.clear();
+    p.stopping = false;
+#endif
+}
+
+// Call fn(begin, end) over disjoint ranges covering [0, count), possibly
+// from several threads at once; returns when all are done. Render thread
+// only (one job at a time).
+template <typename Fn>
+static void parallel_for(size_t count, const Fn& fn) {
+    WorkerPool& p = g_workers;
+    if (count == 0) return;
+    if (p.threads.empty() || count < PARALLEL_MIN_ITEMS) {
+        fn(size_t{ 0 }, count);
+        return;
+    }
+
+    const size_t ways = p.threads.size() + 1;
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        p.fn = [](const void* ctx, size_t begin, size_t end) {
+            (*static_cast<const Fn*>(ctx))(begin, end);
+        };
+        p.ctx = &fn;
+        p.count = count;
+        p.chunk = std::max(PARALLEL_MIN_CHUNK, count / (ways * 4));
+        p.next.store(0, std::memory_order_relaxed);
+        p.busy = static_cast<int>(p.threads.size());
+        ++p.generation;
+    }
+    p.wake.notify_all();
+
+    worker_run_chunks(p);
+
+    std::unique_lock<std::mutex> lock(p.mutex);
+    p.done.wait(lock, [&] { return p.busy == 0; });
 }
 
+
 // ----------------------
 // Wheel rendering helpers
 // ----------------------
@@ -883,6 +3296,192 @@ void SetIcon(SDL_Window* win)
     }
 }
 
+static constexpr int   WHEEL_SLICE_SEGMENTS = 32; // max triangles per wheel slice
+static constexpr int   CIRCLE_SEGMENTS = 96;      // max segments for full circles
+static constexpr float LOD_SEGMENT_PX = 6.0f;     // target rim length per segment
+static constexpr float MIN_LABEL_SPAN_PX = 7.0f;  // thinner slices get no label
+
+// Vertex/index buffer that collects many triangle fans so they can be
+// submitted with a single SDL_RenderGeometry call. Buffers keep their
+// capacity between frames.
+struct GeometryBatch {
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int>        indices;
+
+    void clear() {
+        vertices.clear();
+        indices.clear();
+    }
+};
+
+static SDL_FColor to_fcolor(SDL_Color c) {
+    return SDL_FColor{ c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+}
+
+// Append a triangle fan from (cx, cy) through `count` rim points given as
+// unit vectors (every `stride`-th entry of `unit`), rotated by
+// (rotCos, rotSin) and scaled by radius.
+static void batch_add_fan(GeometryBatch& batch,
+    float cx, float cy,
+    float radius,
+    const SDL_FPoint* unit,
+    int count,
+    float rotCos,
+    float rotSin,
+    SDL_FColor color,
+    int stride = 1)
+{
+    if (count < 2) return;
+
+    int base = static_cast<int>(batch.vertices.size());
+
+    SDL_Vertex v;
+    v.color = color;
+    v.tex_coord = SDL_FPoint{ 0.0f, 0.0f };
+
+    v.position = SDL_FPoint{ cx, cy };
+    batch.vertices.push_back(v);
+
+    for (int i = 0; i < count; ++i) {
+        const SDL_FPoint& u = unit[static_cast<size_t>(i) * stride];
+        float ux = u.x * rotCos - u.y * rotSin;
+        float uy = u.x * rotSin + u.y * rotCos;
+        v.position = SDL_FPoint{ cx + radius * ux, cy + radius * uy };
+        batch.vertices.push_back(v);
+    }
+
+    for (int i = 1; i < count; ++i) {
+        batch.indices.push_back(base);
+        batch.indices.push_back(base + i);
+        batch.indices.push_back(base + i + 1);
+    }
+}
+
+static void batch_submit(SDL_Renderer* renderer, const GeometryBatch& batch) {
+    if (batch.indices.empty()) return;
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderGeometry(renderer, nullptr,
+        batch.vertices.data(), static_cast<int>(batch.vertices.size()),
+        batch.indices.data(), static_cast<int>(batch.indices.size()));
+}
+
+// Unit circle sampled at CIRCLE_SEGMENTS + 1 points (last == first)
+static const SDL_FPoint* unit_circle_table() {
+    static SDL_FPoint table[CIRCLE_SEGMENTS + 1];
+    static bool built = false;
+    if (!built) {
+        const float TWO_PI = 2.0f * 3.14159265358979323846f;
+        for (int i = 0; i <= CIRCLE_SEGMENTS; ++i) {
+            float a = (TWO_PI * i) / CIRCLE_SEGMENTS;
+            table[i] = SDL_FPoint{ std::cos(a), std::sin(a) };
+        }
+        table[CIRCLE_SEGMENTS] = table[0];
+        built = true;
+    }
+    return table;
+}
+
+// Level of detail: enough segments that each covers about LOD_SEGMENT_PX
+// of rim, so tessellation follows on-screen size rather than entry count.
+static int slice_segments(float radius, float sliceAngle) {
+    int segments = static_cast<int>(std::ceil(radius * sliceAngle / LOD_SEGMENT_PX));
+    return std::clamp(segments, 1, WHEEL_SLICE_SEGMENTS);
+}
+
+// Step through unit_circle_table() for a circle of this radius. Strides
+// divide CIRCLE_SEGMENTS evenly (12, 24, 48 or 96 segments).
+static int circle_stride(float radius) {
+    const float TWO_PI = 2.0f * 3.14159265358979323846f;
+    float circumference = TWO_PI * std::max(0.0f, radius);
+    int stride = 8;
+    while (stride > 1 &&
+           circumference / (CIRCLE_SEGMENTS / stride) > LOD_SEGMENT_PX) {
+        stride /= 2;
+    }
+    return stride;
+}
+
+static void batch_add_circle(GeometryBatch& batch,
+    float cx, float cy, float radius,
+    SDL_Color color)
+{
+    int stride = circle_stride(radius);
+    batch_add_fan(batch, cx, cy, radius,
+        unit_circle_table(), CIRCLE_SEGMENTS / stride + 1,
+        1.0f, 0.0f,
+        to_fcolor(color),
+        stride);
+}
+
+// Slice boundaries and rim unit vectors in wheel space (unrotated). Slice
+// i spans [start[i], start[i + 1]), its share of the total weight, and
+// uses points [first[i], first[i + 1]]; neighbours share the boundary
+// point. Rebuilt only when the entries or the wheel size change.
+struct WheelSliceTable {
+    std::vector<float>      start;  // n + 1 boundary angles, start[n] == 2pi
+    std::vector<uint32_t>   first;  // n + 1 offsets into points
+    std::vector<SDL_FPoint> points;
+    uint64_t version = ~0ull;
+    float    radius = -1.0f;
+};
+
+static const WheelSliceTable& wheel_slice_table(const EntryStore& entries,
+    uint64_t entries_version,
+    float radius)
+{
+    static WheelSliceTable table;
+    if (entries_version == table.version && radius == table.radius) {
+        return table;
+    }
+    table.version = entries_version;
+    table.radius = radius;
+
+    const double TWO_PI = 2.0 * 3.14159265358979323846;
+    size_t n = entries.size();
+    table.start.resize(n + 1);
+    table.first.resize(n + 1);
+    table.points.clear();
+
+    // Running prefix sum of the weights, the same one the Fenwick tree holds
+    double total = static_cast<double>(entries.total_weight);
+    uint64_t sum = 0;
+    table.start[0] = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        sum += entries.weights[i];
+        table.start[i + 1] = static_cast<float>(TWO_PI * static_cast<double>(sum) / total);
+    }
+    if (n > 0) {
+        table.start[n] = static_cast<float>(TWO_PI);
+    }
+
+    // Offsets first, then the cos/sin fill split across the worker pool
+    uint32_t points = 0;
+    for (size_t i = 0; i < n; ++i) {
+        table.first[i] = points;
+        points += static_cast<uint32_t>(
+            slice_segments(radius, table.start[i + 1] - table.start[i]));
+    }
+    table.first[n] = points;
+    table.points.resize(n > 0 ? points + 1 : 0);
+
+    parallel_for(n, [](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float a0 = table.start[i];
+            float span = table.start[i + 1] - a0;
+            uint32_t first = table.first[i];
+            int segments = static_cast<int>(table.first[i + 1] - first);
+            for (int k = 0; k < segments; ++k) {
+                float a = a0 + span * k / segments;
+                table.points[first + k] = SDL_FPoint{ std::cos(a), std::sin(a) };
+            }
+        }
+    });
+    if (n > 0) {
+        table.points[points] = table.points[0]; // closes the last slice
+    }
+    return table;
+}
+
 static void draw_filled_sector(SDL_Renderer* renderer,
     float cx, float cy,
     float radius,
@@ -891,54 +3490,37 @@ static void draw_filled_sector(SDL_Renderer* renderer,
     SDL_Color color) {
     if (endAngle <= startAngle) return;
 
-    const int segments = 32;
+    const int segments = slice_segments(radius, endAngle - startAngle);
     float delta = (endAngle - startAngle) / segments;
 
-    SDL_FColor fcolor;
-    fcolor.r = color.r / 255.0f;
-    fcolor.g = color.g / 255.0f;
-    fcolor.b = color.b / 255.0f;
-    fcolor.a = color.a / 255.0f;
-
-    for (int i = 0; i < segments; ++i) {
-        float a0 = startAngle + delta * i;
-        float a1 = startAngle + delta * (i + 1);
-
-        SDL_Vertex verts[3];
-        verts[0].position = SDL_FPoint{ cx, cy };
-        verts[0].color = fcolor;
-        verts[0].tex_coord = SDL_FPoint{ 0.0f, 0.0f };
-
-        verts[1].position = SDL_FPoint{ cx + radius * std::cos(a0),
-                                         cy + radius * std::sin(a0) };
-        verts[1].color = fcolor;
-        verts[1].tex_coord = SDL_FPoint{ 0.0f, 0.0f };
-
-        verts[2].position = SDL_FPoint{ cx + radius * std::cos(a1),
-                                         cy + radius * std::sin(a1) };
-        verts[2].color = fcolor;
-        verts[2].tex_coord = SDL_FPoint{ 0.0f, 0.0f };
-
-        SDL_RenderGeometry(renderer, nullptr, verts, 3, nullptr, 0);
+    SDL_FPoint rim[WHEEL_SLICE_SEGMENTS + 1];
+    for (int i = 0; i <= segments; ++i) {
+        float a = startAngle + delta * i;
+        rim[i] = SDL_FPoint{ std::cos(a), std::sin(a) };
     }
+
+    static GeometryBatch batch;
+    batch.clear();
+    batch_add_fan(batch, cx, cy, radius, rim, segments + 1, 1.0f, 0.0f, to_fcolor(color));
+    batch_submit(renderer, batch);
 }
 
 static void draw_circle_outline(SDL_Renderer* renderer,
     float cx, float cy, float radius,
     SDL_Color color) {
     SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    const int segments = 96;
-    float prevX = cx + radius;
-    float prevY = cy;
 
-    for (int i = 1; i <= segments; ++i) {
-        float angle = (2.0f * 3.14159265358979323846f * i) / segments;
-        float x = cx + radius * std::cos(angle);
-        float y = cy + radius * std::sin(angle);
-        SDL_RenderLine(renderer, prevX, prevY, x, y);
-        prevX = x;
-        prevY = y;
+    const SDL_FPoint* unit = unit_circle_table();
+    const int stride = circle_stride(radius);
+    const int segments = CIRCLE_SEGMENTS / stride;
+
+    SDL_FPoint points[CIRCLE_SEGMENTS + 1];
+    for (int i = 0; i <= segments; ++i) {
+        const SDL_FPoint& u = unit[i * stride];
+        points[i] = SDL_FPoint{ cx + radius * u.x, cy + radius * u.y };
     }
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderLines(renderer, points, segments + 1);
 }
 
 
@@ -946,7 +3528,59 @@ static void draw_circle_outline(SDL_Renderer* renderer,
 // Timer rendering helpers
 // -----------------------
 
-// Rounded rectangle fill using our sector helper for the corners
+// Rounded rectangle as one convex fan: the centre plus four quarter arcs
+// taken from unit_circle_table(), so each rect is a single geometry call
+// instead of three fill rects and four sectors.
+static void batch_add_rounded_rect(GeometryBatch& batch,
+    float x, float y,
+    float w, float h,
+    float radius,
+    SDL_Color color)
+{
+    if (w <= 0.0f || h <= 0.0f) return;
+
+    if (radius < 0.0f) radius = 0.0f;
+    if (radius > w * 0.5f) radius = w * 0.5f;
+    if (radius > h * 0.5f) radius = h * 0.5f;
+
+    const SDL_FPoint* unit = unit_circle_table();
+    const int stride = circle_stride(radius);
+    const int quarter = CIRCLE_SEGMENTS / 4 / stride;
+
+    // Corner centres in table order: angle 0 points right, y grows down
+    const SDL_FPoint corners[4] = {
+        { x + w - radius, y + h - radius },
+        { x + radius,     y + h - radius },
+        { x + radius,     y + radius },
+        { x + w - radius, y + radius },
+    };
+
+    int base = static_cast<int>(batch.vertices.size());
+
+    SDL_Vertex v;
+    v.color = to_fcolor(color);
+    v.tex_coord = SDL_FPoint{ 0.0f, 0.0f };
+
+    v.position = SDL_FPoint{ x + w * 0.5f, y + h * 0.5f };
+    batch.vertices.push_back(v);
+
+    for (int c = 0; c < 4; ++c) {
+        for (int k = 0; k <= quarter; ++k) {
+            const SDL_FPoint& u = unit[(c * quarter + k) * stride];
+            v.position = SDL_FPoint{ corners[c].x + radius * u.x,
+                                     corners[c].y + radius * u.y };
+            batch.vertices.push_back(v);
+        }
+    }
+
+    const int count = 4 * (quarter + 1);
+    for (int i = 1; i <= count; ++i) {
+        batch.indices.push_back(base);
+        batch.indices.push_back(base + i);
+        batch.indices.push_back(base + (i < count ? i + 1 : 1));
+    }
+}
+
 static void draw_filled_rounded_rect(SDL_Renderer* renderer,
     float x, float y,
     float w, float h,
@@ -955,88 +3589,278 @@ static void draw_filled_rounded_rect(SDL_Renderer* renderer,
 {
     if (!renderer) return;
 
-    if (radius < 0.0f) radius = 0.0f;
-    if (radius > w * 0.5f) radius = w * 0.5f;
-    if (radius > h * 0.5f) radius = h * 0.5f;
+    static GeometryBatch batch;
+    batch.clear();
+    batch_add_rounded_rect(batch, x, y, w, h, radius, color);
+    batch_submit(renderer, batch);
+}
+
+// Draw a single 7-segment digit in a rect [x,y,w,h]
+// Draw a single 7-segment digit in a rect [x,y,w,h]
+// Draw a single 7-segment digit in a rect [x,y,w,h]
+
+
+// Entry under the pointer: the pointer's wheel-space angle picks a
+// ticket, and the Fenwick tree finds whose it is in O(log n).
+static int pointer_slice_index(float current_angle, const EntryStore& entries)
+{
+    if (entries.empty() || entries.total_weight == 0) return -1;
+
+    const double PI = 3.14159265358979323846;
+    const double TWO_PI = 2.0 * PI;
+    const double POINTER_ANGLE = -PI * 0.5; // 12 o'clock
+
+    // Angle of the pointer in wheel-space
+    double a = std::fmod(POINTER_ANGLE - current_angle, TWO_PI);
+    if (a < 0.0) a += TWO_PI;
+
+    uint64_t total = entries.total_weight;
+    uint64_t ticket = static_cast<uint64_t>(a / TWO_PI * static_cast<double>(total));
+    if (ticket >= total) ticket = total - 1;
+    return static_cast<int>(entries.find_ticket(ticket));
+}
+
+
+
+static SDL_Color readable_text_color(SDL_Color bg) {
+    // Relative luminance-ish
+    int lum = (int)(0.2126f * bg.r + 0.7152f * bg.g + 0.0722f * bg.b);
+    return (lum < 120) ? SDL_Color{ 255,255,255,255 }
+    : SDL_Color{ 0,0,0,255 };
+}
+
+
+// Wheel center and radius for a w x h output
+static void wheel_placement(int w, int h, float& cx, float& cy, float& radius) {
+    float listWidth   = static_cast<float>(w) * NAME_PANEL_WIDTH_FRAC;
+    float wheelAreaW  = static_cast<float>(w) - listWidth;
+    if (wheelAreaW < 0.0f) {
+        wheelAreaW = static_cast<float>(w); // fallback
+    }
+
+    // Wheel is centered in the left area
+    cx = wheelAreaW * 0.5f;
+    cy = static_cast<float>(h) * 0.5f + CONTENT_Y_OFFSET;
+    radius = std::min(wheelAreaW, static_cast<float>(h)) * 0.45f;
+}
+
+// Where slice labels sit and how much room they have
+struct WheelLabelLayout {
+    float textRadius = 0.0f;     // radius of the label centers
+    float maxTangentSpan = 0.0f; // across the slice
+    float maxRadialSpan = 0.0f;  // along the slice, between hub and rim
+    bool  drawLabels = false;    // false once slices are too thin to read
+};
+
+static WheelLabelLayout wheel_label_layout(float radius, float capR, float sliceAngle) {
+    WheelLabelLayout l;
+    l.textRadius = radius * 0.72f;
+
+    // Tangential span: chord length at that radius for one slice
+    l.maxTangentSpan = 2.0f * l.textRadius * std::sin(sliceAngle * 0.5f);
+
+    // Radial span: how much room we have between rim and hub
+    float inward = l.textRadius - capR * 1.1f;
+    float outward = radius - l.textRadius;
+    l.maxRadialSpan = 2.0f * std::max(0.0f, std::min(inward, outward));
+
+    l.drawLabels = l.maxTangentSpan >= MIN_LABEL_SPAN_PX;
+    return l;
+}
+
+// Slice fill color with the pointer / winner highlight applied
+static SDL_Color slice_fill_color(SDL_Color col, bool bright, bool winner) {
+    int add = bright ? 70 : (winner ? 40 : 0);
+    if (add > 0) {
+        col.r = static_cast<Uint8>(std::min<int>(255, col.r + add));
+        col.g = static_cast<Uint8>(std::min<int>(255, col.g + add));
+        col.b = static_cast<Uint8>(std::min<int>(255, col.b + add));
+    }
+    return col;
+}
+
+static void batch_add_slice(GeometryBatch& batch,
+    const WheelSliceTable& slices,
+    int index,
+    float cx, float cy, float radius,
+    float rotCos, float rotSin,
+    SDL_Color color)
+{
+    uint32_t first = slices.first[index];
+    batch_add_fan(batch, cx, cy, radius,
+        &slices.points[first],
+        static_cast<int>(slices.first[index + 1] - first) + 1,
+        rotCos, rotSin,
+        to_fcolor(color));
+}
+
+// Every slice at once, one fan each in colors[i]. Slice i's fan takes
+// first[i + 1] - first[i] + 2 vertices and three indices per rim step, so
+// it starts at vertex first[i] + 2i and index 3 * first[i]. The buffers
+// are sized once and the worker pool fills disjoint ranges of them.
+static void batch_add_slices(GeometryBatch& batch,
+    const WheelSliceTable& slices,
+    const SDL_Color* colors,
+    float cx, float cy, float radius,
+    float rotCos, float rotSin)
+{
+    if (slices.first.size() < 2) return;
+    const size_t n = slices.first.size() - 1;
+    const size_t points = slices.first[n];
+    const size_t baseVertex = batch.vertices.size();
+    const size_t baseIndex = batch.indices.size();
+    batch.vertices.resize(baseVertex + points + 2 * n);
+    batch.indices.resize(baseIndex + 3 * points);
+
+    SDL_Vertex* vertices = batch.vertices.data();
+    int* indices = batch.indices.data();
+    parallel_for(n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t first = slices.first[i];
+            const int steps = static_cast<int>(slices.first[i + 1] - first);
+            const size_t v0 = baseVertex + first + 2 * i;
+
+            SDL_Vertex v;
+            v.color = to_fcolor(colors[i]);
+            v.tex_coord = SDL_FPoint{ 0.0f, 0.0f };
+            v.position = SDL_FPoint{ cx, cy };
+            vertices[v0] = v;
+            for (int k = 0; k <= steps; ++k) {
+                const SDL_FPoint& u = slices.points[first + k];
+                float ux = u.x * rotCos - u.y * rotSin;
+                float uy = u.x * rotSin + u.y * rotCos;
+                v.position = SDL_FPoint{ cx + radius * ux, cy + radius * uy };
+                vertices[v0 + 1 + k] = v;
+            }
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            int* idx = indices + baseIndex + 3 * static_cast<size_t>(first);
+            const int base = static_cast<int>(v0);
+            for (int k = 1; k <= steps; ++k) {
+                *idx++ = base;
+                *idx++ = base + k;
+                *idx++ = base + k + 1;
+            }
+        }
+    });
+}
 
-    // Center and side rectangles
-    SDL_FRect centerRect{ x + radius, y, w - 2.0f * radius, h };
-    SDL_RenderFillRect(renderer, &centerRect);
+// Middle of slice i and the label room it has
+static float slice_mid_angle(const WheelSliceTable& slices, int i) {
+    return 0.5f * (slices.start[i] + slices.start[i + 1]);
+}
 
-    SDL_FRect leftRect{ x, y + radius, radius, h - 2.0f * radius };
-    SDL_RenderFillRect(renderer, &leftRect);
+static WheelLabelLayout slice_label_layout(const WheelSliceTable& slices, int i,
+    float radius, float capR)
+{
+    return wheel_label_layout(radius, capR, slices.start[i + 1] - slices.start[i]);
+}
 
-    SDL_FRect rightRect{ x + w - radius, y + radius, radius, h - 2.0f * radius };
-    SDL_RenderFillRect(renderer, &rightRect);
+// Offscreen render of the slices and their labels at angle 0. While a spin
+// is running the entries can't change, so draw_wheel just rotates this.
+struct WheelTextureCache {
+    SDL_Texture* texture = nullptr;
+    int      size = 0;        // texture is size x size, wheel centered
+    uint64_t version = ~0ull; // entries_version it was built for
+    bool     valid = false;
+    bool     unsupported = false;
+};
 
-    const float PI = 3.14159265358979323846f;
+static WheelTextureCache g_wheel_cache;
 
-    // Four quarter-circle corners using the existing draw_filled_sector helper
-    // top-left
-    draw_filled_sector(renderer,
-        x + radius, y + radius,
-        radius,
-        PI, PI * 1.5f,
-        color);
-    // top-right
-    draw_filled_sector(renderer,
-        x + w - radius, y + radius,
-        radius,
-        PI * 1.5f, PI * 2.0f,
-        color);
-    // bottom-right
-    draw_filled_sector(renderer,
-        x + w - radius, y + h - radius,
-        radius,
-        0.0f, PI * 0.5f,
-        color);
-    // bottom-left
-    draw_filled_sector(renderer,
-        x + radius, y + h - radius,
-        radius,
-        PI * 0.5f, PI,
-        color);
+static void wheel_texture_invalidate() {
+    g_wheel_cache.valid = false;
 }
 
-// Draw a single 7-segment digit in a rect [x,y,w,h]
-// Draw a single 7-segment digit in a rect [x,y,w,h]
-// Draw a single 7-segment digit in a rect [x,y,w,h]
+static SDL_Texture* get_wheel_texture(SDL_Renderer* renderer,
+    TTF_Font* font,
+    const EntryStore& entries,
+    uint64_t entries_version,
+    float radius,
+    float capR)
+{
+    WheelTextureCache& c = g_wheel_cache;
+    if (c.unsupported) return nullptr;
 
+    int n = static_cast<int>(entries.size());
+    int size = static_cast<int>(std::ceil(radius * 2.0f)) + 2;
 
-static int pointer_slice_index(float current_angle, int n)
-{
-    if (n <= 0) return -1;
+    if (c.texture && c.valid && c.size == size && c.version == entries_version) {
+        return c.texture;
+    }
 
-    const float PI = 3.14159265358979323846f;
-    const float TWO_PI = 2.0f * PI;
-    const float POINTER_ANGLE = -PI * 0.5f; // 12 o'clock
+    if (c.texture && c.size != size) {
+        SDL_DestroyTexture(c.texture);
+        c.texture = nullptr;
+    }
 
-    float sliceAngle = TWO_PI / n;
+    if (!c.texture) {
+        prof_count(PROF_TEXTURES_CREATED);
+        c.texture = SDL_CreateTexture(renderer,
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_TARGET,
+            size, size);
+        if (!c.texture) {
+            log_error("[Wheel] SDL_CreateTexture (wheel) failed: %s", SDL_GetError());
+            c.unsupported = true; // keep drawing the wheel directly
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(c.texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(c.texture, SDL_SCALEMODE_LINEAR);
+        c.size = size;
+    }
 
-    // Angle of the pointer in wheel-space
-    float a = std::fmod(POINTER_ANGLE - current_angle, TWO_PI);
-    if (a < 0.0f) a += TWO_PI;
+    SDL_Texture* previous = SDL_GetRenderTarget(renderer);
+    if (!SDL_SetRenderTarget(renderer, c.texture)) {
+        log_error("[Wheel] SDL_SetRenderTarget (wheel) failed: %s", SDL_GetError());
+        SDL_DestroyTexture(c.texture);
+        c.texture = nullptr;
+        c.unsupported = true; // report once, keep drawing the wheel directly
+        return nullptr;
+    }
 
-    int index = static_cast<int>(a / sliceAngle);
-    if (index >= n) index = n - 1;
-    return index;
-}
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderClear(renderer);
 
+    float center = size * 0.5f;
+    const WheelSliceTable& slices = wheel_slice_table(entries, entries_version, radius);
 
+    static GeometryBatch batch;
+    batch.clear();
+    if (n > 0) {
+        batch_add_slices(batch, slices, entries.colors.data(),
+            center, center, radius, 1.0f, 0.0f);
+    }
+    batch_submit(renderer, batch);
 
-static SDL_Color readable_text_color(SDL_Color bg) {
-    // Relative luminance-ish
-    int lum = (int)(0.2126f * bg.r + 0.7152f * bg.g + 0.0722f * bg.b);
-    return (lum < 120) ? SDL_Color{ 255,255,255,255 }
-    : SDL_Color{ 0,0,0,255 };
-}
+    if (font) {
+        for (int i = 0; i < n; ++i) {
+            WheelLabelLayout layout = slice_label_layout(slices, i, radius, capR);
+            if (!layout.drawLabels) continue;
+            const LabelTexture* label = entry_label(renderer, g_entry_labels.wheel, i,
+                font, entries.name(i), readable_text_color(entries.colors[i]));
+            render_label_radial(renderer,
+                label,
+                center,
+                center,
+                layout.textRadius,
+                slice_mid_angle(slices, i),
+                layout.maxTangentSpan,
+                layout.maxRadialSpan);
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, previous);
 
+    c.version = entries_version;
+    c.valid = true;
+    return c.texture;
+}
 
 static void draw_wheel(SDL_Renderer* renderer,
     TTF_Font* font,
-    const std::vector<WheelEntry>& entries,
+    const EntryStore& entries,
+    uint64_t entries_version,
     float current_angle,
     int winner_index,
     bool spinning,
@@ -1048,19 +3872,33 @@ static void draw_wheel(SDL_Renderer* renderer,
     int w = 0, h = 0;
     SDL_GetRenderOutputSize(renderer, &w, &h);
 
-float listWidth   = static_cast<float>(w) * NAME_PANEL_WIDTH_FRAC;
-float wheelAreaW  = static_cast<float>(w) - listWidth;
-if (wheelAreaW < 0.0f) {
-    wheelAreaW = static_cast<float>(w); // fallback
-}
-
-// Wheel is centered in the left area
-float cx = wheelAreaW * 0.5f;
-float cy = static_cast<float>(h) * 0.5f + CONTENT_Y_OFFSET;
-float radius = std::min(wheelAreaW, static_cast<float>(h)) * 0.45f;
+    float cx = 0.0f, cy = 0.0f, radius = 0.0f;
+    wheel_placement(w, h, cx, cy, radius);
 
     int n = static_cast<int>(entries.size());
-    const float TWO_PI = 2.0f * 3.14159265358979323846f;
+
+    int   active_index = (spinning && n > 0) ? pointer_slice_index(current_angle, entries) : -1;
+    int   highlight_index = spinning ? active_index
+                                     : ((winner_index >= 0 && winner_index < n) ? winner_index : -1);
+    float capR = radius * 0.18f;
+
+    const WheelSliceTable& slices = wheel_slice_table(entries, entries_version, radius);
+
+    // Only the angle and one highlighted slice ever change, so the slices
+    // and labels come from a cached texture that is just rotated. That
+    // keeps the wheel at a handful of draw calls whatever the entry count,
+    // which matters most for the WebGL build. Per-slice drawing remains
+    // the fallback when the texture can't be created.
+    SDL_Texture* wheelTexture = nullptr;
+    if (n > 0) {
+        wheelTexture = get_wheel_texture(renderer, font, entries, entries_version,
+            radius, capR);
+    }
+
+    // Shadow, slices, highlight and hub cap are collected into one batch
+    // and submitted with a single SDL_RenderGeometry call.
+    static GeometryBatch batch;
+    batch.clear();
 
     // --- Drop shadow to lower-left (always visible) ---
     const float shadow_dx = -radius * 0.19f;
@@ -1068,105 +3906,107 @@ float radius = std::min(wheelAreaW, static_cast<float>(h)) * 0.45f;
     const float shadow_r = radius * 1.02f;
     SDL_Color shadowCol{ 0, 0, 0, 70 };
 
-    draw_filled_sector(renderer,
+    batch_add_circle(batch,
         cx + shadow_dx,
         cy + shadow_dy,
         shadow_r,
-        0.0f,
-        TWO_PI,
         shadowCol);
 
-    // --- Colored slices and labels (only if we have entries) ---
-    float sliceAngle = 0.0f;
-    int   active_index = -1;
-
-    if (n > 0) {
-        sliceAngle = TWO_PI / n;
-        active_index = spinning ? pointer_slice_index(current_angle, n) : -1;
-
-        for (int i = 0; i < n; ++i) {
-            float start = current_angle + i * sliceAngle;
-            float end = start + sliceAngle;
-
-            SDL_Color col = entries[i].color;
+    // --- Colored slices (only if we have entries) ---
+    const float rotCos = std::cos(current_angle);
+    const float rotSin = std::sin(current_angle);
 
-            bool isActive = spinning && (i == active_index);
-            bool isWinner = (!spinning) && (i == winner_index);
-            bool isFlash = isWinner && winner_flash_on;
+    if (wheelTexture) {
+        // Shadow must land under the cached wheel
+        batch_submit(renderer, batch);
+        batch.clear();
 
-            if (isActive || isFlash) {
-                col.r = static_cast<Uint8>(std::min<int>(255, col.r + 70));
-                col.g = static_cast<Uint8>(std::min<int>(255, col.g + 70));
-                col.b = static_cast<Uint8>(std::min<int>(255, col.b + 70));
-            }
-            else if (isWinner) {
-                col.r = static_cast<Uint8>(std::min<int>(255, col.r + 40));
-                col.g = static_cast<Uint8>(std::min<int>(255, col.g + 40));
-                col.b = static_cast<Uint8>(std::min<int>(255, col.b + 40));
-            }
+        const float RAD_TO_DEG = 180.0f / 3.14159265358979323846f;
+        float size = static_cast<float>(g_wheel_cache.size);
 
-            draw_filled_sector(renderer, cx, cy, radius, start, end, col);
+        SDL_FRect dst{ cx - size * 0.5f, cy - size * 0.5f, size, size };
+        SDL_FPoint pivot{ size * 0.5f, size * 0.5f };
+        prof_count(PROF_DRAW_CALLS);
+        SDL_RenderTextureRotated(renderer, wheelTexture, nullptr, &dst,
+            current_angle * RAD_TO_DEG, &pivot, SDL_FLIP_NONE);
+    }
+    else if (n > 0) {
+        // Precomputed wheel-space rim points, rotated by current_angle
+        batch_add_slices(batch, slices, entries.colors.data(),
+            cx, cy, radius, rotCos, rotSin);
+    }
 
-            if (isActive || isFlash) {
-                SDL_Color glow{ 255, 255, 255, 80 };
-                draw_filled_sector(renderer, cx, cy, radius, start, end, glow);
-            }
+    // Only the pointer or winner slice is redrawn on top; the glow goes
+    // after it so it blends over the brightened fill
+    if (highlight_index >= 0) {
+        bool isWinner = !spinning;
+        bool bright = spinning || winner_flash_on;
+        batch_add_slice(batch, slices, highlight_index, cx, cy, radius, rotCos, rotSin,
+            slice_fill_color(entries.colors[highlight_index], bright, isWinner));
+        if (bright) {
+            batch_add_slice(batch, slices, highlight_index, cx, cy, radius, rotCos, rotSin,
+                SDL_Color{ 255, 255, 255, 80 });
         }
     }
 
+    // --- Center cap (always drawn) ---
+    // Labels are sized to stay clear of the cap, so it can share the batch.
+    batch_add_circle(batch, cx, cy, capR, SDL_Color{ 5, 40, 10, 255 });
+
+    batch_submit(renderer, batch);
+
     // Rim is always visible, even with zero entries
     draw_circle_outline(renderer, cx, cy, radius, SDL_Color{ 40, 40, 40, 255 });
 
-    // --- Text labels (only if we have entries) ---
-    // --- Text labels (only if we have entries) ---
+    // --- Text labels (only on slices wide enough to read) ---
     if (n > 0 && font) {
-        // Radius where labels sit
-        float outerTextRadius = radius * 0.72f;
-
-        // Tangential span: chord length at that radius for one slice
-        float maxTangentSpan =
-            2.0f * outerTextRadius * std::sin(sliceAngle * 0.5f);
-
-        // Radial span: how much room we have between rim and hub
-        float capR = radius * 0.18f;
-        float inward = outerTextRadius - capR * 1.1f;
-        float outward = radius - outerTextRadius;
-        float maxRadialSpan =
-            2.0f * std::max(0.0f, std::min(inward, outward));
-
-        for (int i = 0; i < n; ++i) {
-            float midAngle = current_angle + (i + 0.5f) * sliceAngle;
-
-            SDL_Color sliceCol = entries[i].color;
-            SDL_Color textColor = readable_text_color(sliceCol);
-
-            if (spinning && i == active_index) {
-                textColor = SDL_Color{ 0, 0, 0, 255 };
+        const SDL_Color black{ 0, 0, 0, 255 };
+
+        if (wheelTexture) {
+            // The cached texture already holds the regular labels
+            WheelLabelLayout layout = (highlight_index >= 0)
+                ? slice_label_layout(slices, highlight_index, radius, capR) : WheelLabelLayout{};
+            if (layout.drawLabels) {
+                float midAngle = current_angle + slice_mid_angle(slices, highlight_index);
+                const LabelTexture* label = entry_label(renderer,
+                    g_entry_labels.wheel_dark, highlight_index,
+                    font, entries.name(highlight_index), black);
+                render_label_radial(renderer, label,
+                    cx, cy, layout.textRadius, midAngle,
+                    layout.maxTangentSpan, layout.maxRadialSpan);
             }
-            else if (!spinning && i == winner_index) {
-                textColor = SDL_Color{ 0, 0, 0, 255 };
+        }
+        else {
+            for (int i = 0; i < n; ++i) {
+                WheelLabelLayout layout = slice_label_layout(slices, i, radius, capR);
+                if (!layout.drawLabels) continue;
+                float midAngle = current_angle + slice_mid_angle(slices, i);
+
+                // Active / winner slices get black text
+                bool dark = (spinning && i == active_index) ||
+                            (!spinning && i == winner_index);
+
+                const LabelTexture* label = dark
+                    ? entry_label(renderer, g_entry_labels.wheel_dark, i,
+                        font, entries.name(i), black)
+                    : entry_label(renderer, g_entry_labels.wheel, i,
+                        font, entries.name(i), readable_text_color(entries.colors[i]));
+
+                // Draw label rotated so it "paints" onto the slice
+                render_label_radial(renderer,
+                    label,
+                    cx,
+                    cy,
+                    layout.textRadius,
+                    midAngle,
+                    layout.maxTangentSpan,
+                    layout.maxRadialSpan);
             }
-
-            // Draw label rotated so it "paints" onto the slice
-            render_text_radial(renderer,
-                font,
-                entries[i].name,
-                textColor,
-                cx,
-                cy,
-                outerTextRadius,
-                midAngle,
-                maxTangentSpan,
-                maxRadialSpan);
         }
     }
 
 
-    // --- Center cap & Waka sprite (always drawn) ---
-    float capR = radius * 0.18f;
-
-    draw_filled_sector(renderer, cx, cy, capR, 0.0f, TWO_PI,
-        SDL_Color{ 5, 40, 10, 255 });
+    // --- Cap outline & Waka sprite (always drawn) ---
     draw_circle_outline(renderer, cx, cy, capR,
         SDL_Color{ 0, 0, 0, 255 });
 
@@ -1190,6 +4030,7 @@ float radius = std::min(wheelAreaW, static_cast<float>(h)) * 0.45f;
 
         double rotationDeg = current_angle * RAD_TO_DEG;
 
+        prof_count(PROF_DRAW_CALLS);
         SDL_RenderTextureRotated(renderer,
             waka_texture,
             nullptr,
@@ -1216,14 +4057,318 @@ float radius = std::min(wheelAreaW, static_cast<float>(h)) * 0.45f;
     }
 }
 
+// ----------------------
+// Name list panel
+// ----------------------
+
+// The list is virtualized: only the rows in view are drawn, and they are
+// kept in a panel texture used as a ring of row slots (content row r lives
+// in slot r % rows). Each frame walks the visible rows and draws only
+// cells that aren't in the texture yet, so appending a joiner costs one
+// label blit and scrolling by k rows redraws k rows. Drawing the panel is
+// two texture blits (either side of the ring's seam).
+//
+// Layout is row-major across two columns (entries 2r and 2r+1 share row r)
+// so appends only ever touch the last row. Scroll with the mouse wheel or
+// PageUp/PageDown/Home/End; '/' or Ctrl+F searches (Enter keeps the
+// filter, Esc clears it).
+static constexpr int NAME_LIST_COLUMNS = 2;
+static constexpr int NAME_LIST_WHEEL_ROWS = 3; // rows per mouse-wheel notch
+
+struct NameListState {
+    // View
+    int   first_row = 0;
+    bool  follow_tail = true;          // keep the newest names in view
+
+    // Search (query is case-folded; matches holds entry indices)
+    bool        searching = false;
+    std::string query;
+    std::vector<uint32_t> matches;
+    size_t      scanned = 0;           // entries already tested against query
+    uint32_t    label_generation = ~0u;
+
+    // Last layout, for input handling between frames
+    SDL_FRect panel{};
+    int       rows = 0;
+    int       total_rows = 0;
+
+    // Panel texture, one slot per visible row
+    SDL_Texture* texture = nullptr;
+    int   tex_w = 0;
+    int   tex_h = 0;
+    int   row_h = 0;
+    std::vector<int>     slot_row;     // content row in each slot, -1 = empty
+    std::vector<uint8_t> slot_cells;   // cells of that row already drawn
+    bool  unsupported = false;
+};
+
+static NameListState g_name_list;
+
+// Forget what the panel texture holds (render targets lost, reset, filter).
+static void name_list_invalidate() {
+    std::fill(g_name_list.slot_row.begin(), g_name_list.slot_row.end(), -1);
+    std::fill(g_name_list.slot_cells.begin(), g_name_list.slot_cells.end(), 0);
+}
+
+static size_t name_list_count(const EntryStore& entries) {
+    return g_name_list.query.empty() ? entries.size() : g_name_list.matches.size();
+}
+
+static size_t name_list_entry(size_t k) {
+    return g_name_list.query.empty() ? k : g_name_list.matches[k];
+}
+
+// Case-insensitive substring test; query is already folded.
+static bool name_matches(std::string_view name, const std::string& query) {
+    static std::string folded;
+    fold_case_into(folded, name);
+    return folded.find(query) != std::string::npos;
+}
+
+// Bring the filter up to date with entries. Entries only ever append, or
+// are cleared on reset (which also bumps the label cache generation); only
+// new entries are tested against the query.
+static void name_list_sync(const EntryStore& entries) {
+    NameListState& s = g_name_list;
+    if (s.label_generation != g_label_cache_generation || entries.size() < s.scanned) {
+        s.label_generation = g_label_cache_generation;
+        s.matches.clear();
+        s.scanned = 0;
+        name_list_invalidate();
+    }
+    if (!s.query.empty()) {
+        for (; s.scanned < entries.size(); ++s.scanned) {
+            if (name_matches(entries.name(s.scanned), s.query)) {
+                s.matches.push_back(static_cast<uint32_t>(s.scanned));
+            }
+        }
+    }
+    s.scanned = entries.size();
+}
+
+static void name_list_set_query(std::string query) {
+    NameListState& s = g_name_list;
+    s.query = fold_case(query);
+    s.matches.clear();
+    s.scanned = 0;
+    s.first_row = 0;
+    s.follow_tail = true;
+    name_list_invalidate();
+    // name_list_sync() refills matches on the next draw
+}
+
+static void name_list_scroll(int deltaRows) {
+    NameListState& s = g_name_list;
+    int maxFirst = std::max(0, s.total_rows - s.rows);
+    s.first_row = std::max(0, std::min(maxFirst, s.first_row + deltaRows));
+    s.follow_tail = (s.first_row >= maxFirst);
+}
+
+static void name_list_stop_search(AppState& a) {
+    g_name_list.searching = false;
+    if (a.window) SDL_StopTextInput(a.window);
+}
+
+// Scrolling and search input. Returns true if the event was consumed;
+// while the search box is open that includes every key, so typing a
+// space or 'b' doesn't spin the wheel or toggle the background.
+static bool name_list_handle_event(AppState& a, const SDL_Event& e) {
+    NameListState& s = g_name_list;
+
+    if (s.searching) {
+        if (e.type == SDL_EVENT_TEXT_INPUT && e.text.text) {
+            name_list_set_query(s.query + e.text.text);
+            return true;
+        }
+        if (e.type == SDL_EVENT_KEY_DOWN) {
+            SDL_Keycode key = e.key.key;
+            if (key == SDLK_BACKSPACE && !s.query.empty()) {
+                std::string q = s.query;
+                // Drop one UTF-8 code point
+                size_t cut = q.size() - 1;
+                while (cut > 0 && (static_cast<unsigned char>(q[cut]) & 0xC0) == 0x80) --cut;
+                q.erase(cut);
+                name_list_set_query(q);
+            }
+            else if (key == SDLK_RETURN) {
+                name_list_stop_search(a);
+            }
+            else if (key == SDLK_ESCAPE) {
+                name_list_stop_search(a);
+                name_list_set_query("");
+            }
+            return true;
+        }
+        if (e.type == SDL_EVENT_KEY_UP) {
+            return true;
+        }
+    }
+    else if (e.type == SDL_EVENT_KEY_DOWN) {
+        SDL_Keycode key = e.key.key;
+        if (key == SDLK_SLASH || (key == SDLK_F && (e.key.mod & SDL_KMOD_CTRL))) {
+            s.searching = true;
+            if (a.window) SDL_StartTextInput(a.window);
+            return true;
+        }
+        switch (key) {
+        case SDLK_PAGEUP:   name_list_scroll(-std::max(1, s.rows - 1)); return true;
+        case SDLK_PAGEDOWN: name_list_scroll(std::max(1, s.rows - 1));  return true;
+        case SDLK_HOME:     name_list_scroll(-s.total_rows);            return true;
+        case SDLK_END:      name_list_scroll(s.total_rows);             return true;
+        default: break;
+        }
+    }
+
+    if (e.type == SDL_EVENT_MOUSE_WHEEL) {
+        SDL_FPoint p{ e.wheel.mouse_x, e.wheel.mouse_y };
+        if (SDL_PointInRectFloat(&p, &s.panel)) {
+            name_list_scroll(static_cast<int>(-e.wheel.y * NAME_LIST_WHEEL_ROWS));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Draw a label clipped to maxW (names longer than a column are cut off).
+static void render_label_clipped(SDL_Renderer* renderer,
+    const LabelTexture* label,
+    float x,
+    float y,
+    float maxW)
+{
+    if (!renderer || !label) return;
+    float w = std::min(label->w, maxW);
+    SDL_FRect src{ 0.0f, 0.0f, w, label->h };
+    SDL_FRect dst{ x, y, w, label->h };
+    prof_count(PROF_DRAW_CALLS);
+    SDL_RenderTexture(renderer, label->texture, &src, &dst);
+}
+
+// One name, clipped to its column: a shaped TTF_Text when the text engine
+// is up, otherwise the cached label texture.
+static void draw_list_cell(SDL_Renderer* renderer,
+    TTF_Font* font,
+    const EntryStore& entries,
+    size_t i,
+    float x,
+    float y,
+    float w,
+    float h)
+{
+    if (g_text_engine) {
+        TTF_Text* text = entry_list_text(i, font, entries.name(i));
+        if (!text) return;
+        SDL_Rect clip{ static_cast<int>(x), static_cast<int>(y),
+            static_cast<int>(w), static_cast<int>(std::ceil(h)) };
+        SDL_SetRenderClipRect(renderer, &clip);
+        prof_count(PROF_DRAW_CALLS);
+        TTF_DrawRendererText(text, x, y);
+        SDL_SetRenderClipRect(renderer, nullptr);
+        return;
+    }
+    const LabelTexture* label = entry_label(renderer, g_entry_labels.list, i,
+        font, entries.name(i), SDL_Color{ 0, 0, 0, 255 });
+    render_label_clipped(renderer, label, x, y, w);
+}
+
+// Make sure the panel texture is rows x row_h tall and contentW wide, then
+// draw whatever visible cells it is missing. Returns false when render
+// targets aren't available; the caller then draws the rows directly.
+static bool name_list_update_texture(SDL_Renderer* renderer,
+    TTF_Font* font,
+    const EntryStore& entries,
+    int contentW,
+    int rows,
+    int rowH,
+    const float colX[NAME_LIST_COLUMNS],
+    float colW)
+{
+    NameListState& s = g_name_list;
+    if (s.unsupported) return false;
+
+    int texH = rows * rowH;
+    if (!s.texture || s.tex_w != contentW || s.tex_h != texH || s.row_h != rowH) {
+        if (s.texture) SDL_DestroyTexture(s.texture);
+        prof_count(PROF_TEXTURES_CREATED);
+        s.texture = SDL_CreateTexture(renderer,
+            SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_TARGET,
+            contentW, texH);
+        if (!s.texture) {
+            std::cerr << "SDL_CreateTexture (name list) failed: "
+                      << SDL_GetError() << "\n";
+            s.unsupported = true;
+            return false;
+        }
+        SDL_SetTextureBlendMode(s.texture, SDL_BLENDMODE_BLEND);
+        s.tex_w = contentW;
+        s.tex_h = texH;
+        s.row_h = rowH;
+        s.slot_row.assign(static_cast<size_t>(rows), -1);
+        s.slot_cells.assign(static_cast<size_t>(rows), 0);
+    }
+
+    size_t total = name_list_count(entries);
+    SDL_Texture* previous = nullptr;
+    bool targetSet = false;
+
+    for (int r = s.first_row; r < s.first_row + rows; ++r) {
+        size_t slot = static_cast<size_t>(r % rows);
+        size_t firstCell = static_cast<size_t>(r) * NAME_LIST_COLUMNS;
+        size_t cellsInRow = (firstCell < total)
+            ? std::min<size_t>(NAME_LIST_COLUMNS, total - firstCell) : 0;
+
+        bool stale = s.slot_row[slot] != r;
+        if (!stale && s.slot_cells[slot] >= cellsInRow) continue;
+
+        if (!targetSet) {
+            previous = SDL_GetRenderTarget(renderer);
+            if (!SDL_SetRenderTarget(renderer, s.texture)) {
+                std::cerr << "SDL_SetRenderTarget (name list) failed: "
+                          << SDL_GetError() << "\n";
+                return false;
+            }
+            targetSet = true;
+        }
+
+        float slotY = static_cast<float>(slot) * rowH;
+        if (stale) {
+            // Wipe the slot to transparent before reusing it
+            SDL_FRect rect{ 0.0f, slotY, static_cast<float>(contentW), static_cast<float>(rowH) };
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            prof_count(PROF_DRAW_CALLS);
+            SDL_RenderFillRect(renderer, &rect);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            s.slot_row[slot] = r;
+            s.slot_cells[slot] = 0;
+        }
+
+        for (size_t c = s.slot_cells[slot]; c < cellsInRow; ++c) {
+            draw_list_cell(renderer, font, entries, name_list_entry(firstCell + c),
+                colX[c], slotY, colW, static_cast<float>(rowH));
+        }
+        s.slot_cells[slot] = static_cast<uint8_t>(cellsInRow);
+    }
+
+    if (targetSet) {
+        SDL_SetRenderTarget(renderer, previous);
+    }
+    return true;
+}
+
 static void draw_name_list(SDL_Renderer* renderer,
                            TTF_Font* font,
-                           const std::vector<WheelEntry>& entries,
+                           const EntryStore& entries,
                            int active_index,
                            int winner_index)
 {
+    (void)active_index;
+    (void)winner_index;
     if (!renderer || !font) return;
 
+    NameListState& s = g_name_list;
+
     int winW = 0, winH = 0;
     SDL_GetRenderOutputSize(renderer, &winW, &winH);
 
@@ -1241,13 +4386,16 @@ static void draw_name_list(SDL_Renderer* renderer,
     float panelY           = (winHF - panelH) * 0.5f + CONTENT_Y_OFFSET;
 
     SDL_FRect panelRect{ panelX, panelY, panelWidth, panelH };
+    s.panel = panelRect;
 
     // Fill panel with white
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderFillRect(renderer, &panelRect);
 
     // Thin black border
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderRect(renderer, &panelRect);
 
     // Text layout inside the panel
@@ -1261,48 +4409,71 @@ static void draw_name_list(SDL_Renderer* renderer,
 
     int   lineSkip = TTF_GetFontLineSkip(font);
     float lineStep = static_cast<float>(lineSkip);
+    if (lineSkip <= 0) return;
+
+    name_list_sync(entries);
+    size_t total = name_list_count(entries);
+
+    // Search line takes the top row while a filter is being typed or kept
+    if (s.searching || !s.query.empty()) {
+        char count[32];
+        std::snprintf(count, sizeof(count), "  (%zu)", total);
+        FrameString line = "find: ";
+        line.append(s.query.data(), s.query.size());
+        line += s.searching ? "_" : "";
+        line += count;
+        // One retained texture, replaced as the query or count changes,
+        // rather than a label cache entry per keystroke
+        const TextWidget* text = text_widget_update(renderer, g_search_text, font,
+            std::string_view(line.data(), line.size()), SDL_Color{ 90, 90, 90, 255 });
+        if (text) {
+            LabelTexture label{ text->texture, text->w, text->h };
+            render_label_clipped(renderer, &label, contentX, contentY, contentW);
+        }
+        contentY += lineStep;
+        contentH -= lineStep;
+    }
 
     int maxRows = static_cast<int>(contentH / lineStep);
+    s.rows = std::max(0, maxRows);
+    s.total_rows = static_cast<int>((total + NAME_LIST_COLUMNS - 1) / NAME_LIST_COLUMNS);
     if (maxRows <= 0) return;
 
-    // Two columns: total visible slots
-    const int numColumns = 2;
-    int maxVisible = maxRows * numColumns;
-    if (maxVisible <= 0) return;
-
-    int total = static_cast<int>(entries.size());
-    int startIndex = 0;
-
-    // If there are more names than fit, show the most recent ones
-    if (total > maxVisible) {
-        startIndex = total - maxVisible;
-    }
+    // Clamp the view; follow the tail unless the user scrolled away from it
+    int maxFirst = std::max(0, s.total_rows - maxRows);
+    s.first_row = s.follow_tail ? maxFirst : std::min(s.first_row, maxFirst);
 
-    // Horizontal layout for two columns
+    // Horizontal layout for two columns, relative to the content box
     float columnGap = 20.0f; // space between columns
     float colWidth  = (contentW - columnGap) * 0.5f;
+    float colX[NAME_LIST_COLUMNS] = { 0.0f, colWidth + columnGap };
+
+    int texW = static_cast<int>(contentW);
+    if (texW > 0 &&
+        name_list_update_texture(renderer, font, entries, texW, maxRows, lineSkip, colX, colWidth)) {
+        // Visible rows start at slot first_row % rows and wrap once
+        int seam = s.first_row % maxRows;
+        float headRows = static_cast<float>(maxRows - seam);
+        SDL_FRect src1{ 0.0f, seam * lineStep, (float)texW, headRows * lineStep };
+        SDL_FRect dst1{ contentX, contentY, (float)texW, headRows * lineStep };
+        prof_count(PROF_DRAW_CALLS);
+        SDL_RenderTexture(renderer, s.texture, &src1, &dst1);
+        if (seam > 0) {
+            SDL_FRect src2{ 0.0f, 0.0f, (float)texW, seam * lineStep };
+            SDL_FRect dst2{ contentX, contentY + headRows * lineStep, (float)texW, seam * lineStep };
+            prof_count(PROF_DRAW_CALLS);
+            SDL_RenderTexture(renderer, s.texture, &src2, &dst2);
+        }
+        return;
+    }
 
-    float colX[2];
-    colX[0] = contentX;
-    colX[1] = contentX + colWidth + columnGap;
-
-    SDL_Color textCol{ 0, 0, 0, 255 };
-
-    // Draw up to maxVisible entries across two columns
-    for (int idx = 0; idx < maxVisible && (startIndex + idx) < total; ++idx) {
-        int i = startIndex + idx;
-
-        int col = idx / maxRows;      // 0 or 1
-        int row = idx % maxRows;      // 0 .. maxRows-1
-
-        if (col >= numColumns)
-            break;
-
-        float x = colX[col];
-        float y = contentY + row * lineStep;
-
-        const auto& e = entries[i];
-        render_text_left(renderer, font, e.name, textCol, x, y);
+    // No render targets: draw the visible rows straight to the screen
+    for (int r = 0; r < maxRows; ++r) {
+        size_t firstCell = static_cast<size_t>(s.first_row + r) * NAME_LIST_COLUMNS;
+        for (size_t c = 0; c < NAME_LIST_COLUMNS && firstCell + c < total; ++c) {
+            draw_list_cell(renderer, font, entries, name_list_entry(firstCell + c),
+                contentX + colX[c], contentY + r * lineStep, colWidth, lineStep);
+        }
     }
 }
 
@@ -1315,6 +4486,7 @@ static void draw_filled_triangle(SDL_Renderer* renderer,
     v[0].position = a; v[0].color = fc; v[0].tex_coord = { 0,0 };
     v[1].position = b; v[1].color = fc; v[1].tex_coord = { 0,0 };
     v[2].position = c; v[2].color = fc; v[2].tex_coord = { 0,0 };
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderGeometry(renderer, nullptr, v, 3, nullptr, 0);
 }
 
@@ -1334,55 +4506,102 @@ static void draw_spin_droplet(SDL_Renderer* renderer,
 }
 
 
-static void draw_background(SDL_Renderer* renderer,
-    SDL_Texture* waka_texture,
-    int waka_w,
-    int waka_h,
-    float offset_x,
-    float offset_y,
-    float angle_deg)
-
+// Bake the dithered background gradient at one texel per cell; the caller
+// scales it up with nearest filtering to get the pixelated look.
+static SDL_Texture* build_background_gradient(SDL_Renderer* renderer,
+    int winW, int winH, int cell)
 {
-    if (!renderer) return;
+    if (!renderer || winW <= 0 || winH <= 0 || cell <= 0) return nullptr;
 
-    int winW = 0, winH = 0;
-    SDL_GetRenderOutputSize(renderer, &winW, &winH);
-
-    // --- Pixelated vertical green gradient with dithering ---
+    int cellsX = (winW + cell - 1) / cell;
+    int cellsY = (winH + cell - 1) / cell;
 
-    const int cell = 4; // size of each "pixel block"
-    SDL_FRect r{ 0, 0, (float)cell, (float)cell };
+    prof_count(PROF_TEXTURES_CREATED);
+    SDL_Texture* texture = SDL_CreateTexture(renderer,
+        SDL_PIXELFORMAT_RGBA32,
+        SDL_TEXTUREACCESS_STATIC,
+        cellsX, cellsY);
+    if (!texture) {
+        std::cerr << "SDL_CreateTexture (background) failed: "
+                  << SDL_GetError() << "\n";
+        return nullptr;
+    }
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
 
     // top and bottom gradient colors (approximate the example)
     const Uint8 rTop = 16, gTop = 88, bTop = 32;
     const Uint8 rBot = 40, gBot = 160, bBot = 72;
 
-    for (int y = 0; y < winH; y += cell) {
+    std::vector<Uint8> pixels(static_cast<size_t>(cellsX) * cellsY * 4);
+
+    for (int cyi = 0; cyi < cellsY; ++cyi) {
+        int y = cyi * cell;
         float t = (float)y / (float)(winH - 1);
         Uint8 baseR = (Uint8)(rTop + t * (rBot - rTop));
         Uint8 baseG = (Uint8)(gTop + t * (gBot - gTop));
         Uint8 baseB = (Uint8)(bTop + t * (bBot - bTop));
 
-        for (int x = 0; x < winW; x += cell) {
+        Uint8* row = pixels.data() + static_cast<size_t>(cyi) * cellsX * 4;
+        for (int cxi = 0; cxi < cellsX; ++cxi) {
             // simple checkerboard dither
-            int checker = ((x / cell) + (y / cell)) & 1;
+            int checker = (cxi + cyi) & 1;
             int delta = checker ? 10 : -10;
 
-            int rCol = baseR + delta;
-            int gCol = baseG + delta;
-            int bCol = baseB + delta;
+            row[cxi * 4 + 0] = (Uint8)std::clamp(baseR + delta, 0, 255);
+            row[cxi * 4 + 1] = (Uint8)std::clamp(baseG + delta, 0, 255);
+            row[cxi * 4 + 2] = (Uint8)std::clamp(baseB + delta, 0, 255);
+            row[cxi * 4 + 3] = 255;
+        }
+    }
+
+    if (!SDL_UpdateTexture(texture, nullptr, pixels.data(), cellsX * 4)) {
+        std::cerr << "SDL_UpdateTexture (background) failed: "
+                  << SDL_GetError() << "\n";
+        SDL_DestroyTexture(texture);
+        return nullptr;
+    }
+    return texture;
+}
+
+static void draw_background(SDL_Renderer* renderer,
+    SDL_Texture* waka_texture,
+    int waka_w,
+    int waka_h,
+    float offset_x,
+    float offset_y,
+    float angle_deg,
+    int sprite_count)
+{
+    if (!renderer) return;
 
-            rCol = std::clamp(rCol, 0, 255);
-            gCol = std::clamp(gCol, 0, 255);
-            bCol = std::clamp(bCol, 0, 255);
+    int winW = 0, winH = 0;
+    SDL_GetRenderOutputSize(renderer, &winW, &winH);
+
+    // --- Pixelated vertical green gradient with dithering ---
+    // The gradient only depends on the window size, so it is baked into a
+    // one-texel-per-cell texture and regenerated on resize, like the sprites.
+    const int cell = 4; // size of each "pixel block"
 
-            SDL_SetRenderDrawColor(renderer,
-                (Uint8)rCol, (Uint8)gCol, (Uint8)bCol, 255);
+    static SDL_Texture* gradient = nullptr;
+    static int gradientW = 0;
+    static int gradientH = 0;
 
-            r.x = (float)x;
-            r.y = (float)y;
-            SDL_RenderFillRect(renderer, &r);
+    if (!gradient || winW != gradientW || winH != gradientH) {
+        if (gradient) {
+            SDL_DestroyTexture(gradient);
         }
+        gradient = build_background_gradient(renderer, winW, winH, cell);
+        gradientW = winW;
+        gradientH = winH;
+    }
+
+    if (gradient) {
+        int cellsX = (winW + cell - 1) / cell;
+        int cellsY = (winH + cell - 1) / cell;
+        SDL_FRect dst{ 0.0f, 0.0f, (float)(cellsX * cell), (float)(cellsY * cell) };
+        prof_count(PROF_DRAW_CALLS);
+        SDL_RenderTexture(renderer, gradient, nullptr, &dst);
     }
 
 
@@ -1398,14 +4617,17 @@ static void draw_background(SDL_Renderer* renderer,
         static std::vector<BgWakaSprite> sprites;
         static int cachedW = 0;
         static int cachedH = 0;
+        static int cachedCount = -1;
 
         auto regenerate = [&](int w, int h) {
             cachedW = w;
             cachedH = h;
+            cachedCount = sprite_count;
             sprites.clear();
 
-            const int count = 6; // keep your density target
-            sprites.reserve(count);
+            // Sized for the largest count once, so a resize reuses it
+            const int count = sprite_count;
+            sprites.reserve(MAX_BACKGROUND_SPRITES);
 
             std::uniform_real_distribution<float> dist01(0.0f, 1.0f);
             std::uniform_real_distribution<float> scaleDist(0.5f, 0.8f);
@@ -1472,26 +4694,51 @@ static void draw_background(SDL_Renderer* renderer,
         };
 
 
-        if (sprites.empty() || winW != cachedW || winH != cachedH) {
+        if (winW != cachedW || winH != cachedH || sprite_count != cachedCount) {
             regenerate(winW, winH);
         }
 
-               SDL_FRect dst{};
+        // Every visible tile goes into one vertex batch and a single
+        // SDL_RenderGeometry call, so density doesn't multiply draw calls.
+        // All sprites share the rotation, so the rotated corner offsets of a
+        // unit quad are computed once per frame and scaled per sprite.
+        static std::vector<SDL_Vertex> verts;
+        static std::vector<int> indices;
+        verts.clear();
+        indices.clear();
+
+        float rad = angle_deg * (3.14159265358979323846f / 180.0f);
+        float c = std::cos(rad);
+        float sn = std::sin(rad);
+
+        // Unit-quad corners (TL, TR, BR, BL) and their texture coordinates
+        static const float cornerX[4] = { -0.5f, 0.5f, 0.5f, -0.5f };
+        static const float cornerY[4] = { -0.5f, -0.5f, 0.5f, 0.5f };
+        static const SDL_FPoint uv[4] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+        const SDL_FColor white{ 1.0f, 1.0f, 1.0f, 1.0f };
 
         for (const auto& s : sprites) {
             // Base position from normalized coords
             float baseX = s.nx * winW;
             float baseY = s.ny * winH;
 
-            dst.w = (float)waka_w * s.scale;
-            dst.h = (float)waka_h * s.scale;
+            float w = (float)waka_w * s.scale;
+            float h = (float)waka_h * s.scale;
+
+            // Rotated corner offsets around the sprite center
+            SDL_FPoint offs[4];
+            for (int k = 0; k < 4; ++k) {
+                float dx = cornerX[k] * w;
+                float dy = cornerY[k] * h;
+                offs[k] = { dx * c - dy * sn, dx * sn + dy * c };
+            }
+            // Conservative extent of the rotated quad for culling
+            float extent = 0.5f * std::sqrt(w * w + h * h);
 
             // Unwrapped position with global drift
             float x0 = baseX + offset_x;
             float y0 = baseY + offset_y;
 
-            SDL_FPoint pivot{ dst.w * 0.5f, dst.h * 0.5f };
-
             // Tile sprites across screen borders so they
             // slide in and out smoothly with no pop-in.
             for (int tileY = -1; tileY <= 1; ++tileY) {
@@ -1499,51 +4746,162 @@ static void draw_background(SDL_Renderer* renderer,
                     float x = x0 + tileX * winW;
                     float y = y0 + tileY * winH;
 
-                    float left   = x - dst.w * 0.5f;
-                    float right  = x + dst.w * 0.5f;
-                    float top    = y - dst.h * 0.5f;
-                    float bottom = y + dst.h * 0.5f;
-
                     // Skip tiles that are completely off-screen
-                    if (right < 0.0f || left > (float)winW ||
-                        bottom < 0.0f || top > (float)winH) {
+                    if (x + extent < 0.0f || x - extent > (float)winW ||
+                        y + extent < 0.0f || y - extent > (float)winH) {
                         continue;
                     }
 
-                    dst.x = left;
-                    dst.y = top;
-
-                    SDL_RenderTextureRotated(renderer,
-                        waka_texture,
-                        nullptr,
-                        &dst,
-                        angle_deg,
-                        &pivot,
-                        SDL_FLIP_NONE);
+                    int base = (int)verts.size();
+                    for (int k = 0; k < 4; ++k) {
+                        verts.push_back({ { x + offs[k].x, y + offs[k].y }, white, uv[k] });
+                    }
+                    indices.insert(indices.end(),
+                        { base, base + 1, base + 2, base, base + 2, base + 3 });
                 }
             }
         }
+
+        if (!verts.empty()) {
+            prof_count(PROF_DRAW_CALLS);
+            SDL_RenderGeometry(renderer,
+                waka_texture,
+                verts.data(), (int)verts.size(),
+                indices.data(), (int)indices.size());
+        }
     }
 }
-static void frame(const TwitchConfig& cfg, float dt)
+
+// ----------------------
+// Frame pacing
+// ----------------------
+
+// Full rate (vsync) while anything but the background moves; IDLE_FPS
+// while only the background drifts; with background animation off, no
+// redraw at all until input, a join or a state change. The scene is idle
+// most of the time a wheel sits on stream, so this is where the CPU/GPU
+// time next to OBS and a game goes.
+static constexpr int IDLE_FPS = 20;
+static constexpr int IDLE_MAX_WAIT_MS = 500; // longest sleep with a static scene
+
+// True while something other than the background changes every frame.
+static bool scene_animating(const AppState& a) {
+    return a.spinning ||
+        a.winner_flash_remaining > 0.0f ||
+        a.reset_hold_active ||
+        (a.celebration_active && a.celebration_time < banner_reveal_seconds(a.celebration_name)) ||
+        g_prof.overlay;
+}
+
+static bool assets_pending();
+
+// Milliseconds the main loop may sleep before running frame(); 0 = now.
+static int idle_wait_ms(const AppState& a, Uint64 msSinceLastFrame) {
+    if (a.redraw_requested || a.last_frame_animating || scene_animating(a)) {
+        return 0;
+    }
+    // Still loading: keep polling so fonts show up as soon as they land
+    if (assets_pending()) {
+        return 0;
+    }
+    // Chat commands waiting for dispatch_chat_commands(). On the web this
+    // is how page joins, spins and resets get a frame at all.
+    if (a.command_queue.ready()) {
+        return 0;
+    }
+    // Entries changed outside frame() (e.g. the web journal replay)
+    if (a.entries_version.load(std::memory_order_acquire) != a.drawn_entries_version) {
+        return 0;
+    }
+    if (a.background_animation) {
+        int interval = 1000 / IDLE_FPS;
+        return std::max(0, interval - static_cast<int>(msSinceLastFrame));
+    }
+    return IDLE_MAX_WAIT_MS;
+}
+
+#ifndef __EMSCRIPTEN__
+// Sleep in SDL_WaitEventTimeout so input wakes us at once; chat joins wake
+// us through notify_command_queued(). The fence pairs with the one there so
+// a join pushed just before we park is seen by ready() or posts the event.
+static void idle_wait(AppState& a, int ms) {
+    a.idle_waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!a.command_queue.ready()) {
+        SDL_WaitEventTimeout(nullptr, ms);
+    }
+    a.idle_waiting.store(false, std::memory_order_relaxed);
+}
+#endif
+
+// Any event but plain mouse motion may change what's on screen
+static void note_event_for_redraw(AppState& a, const SDL_Event& e) {
+    if (e.type != SDL_EVENT_MOUSE_MOTION) {
+        a.redraw_requested = true;
+    }
+}
+
+static void toggle_background_animation(AppState& a) {
+    a.background_animation = !a.background_animation;
+    log_info("[Wheel] Background animation %s", a.background_animation ? "on" : "off");
+}
+
+// Rasterize labels for entries added since the last call, so the wheel and
+// name list passes only ever hit the label cache.
+static void warm_entry_labels(SDL_Renderer* renderer,
+    const EntryStore& entries)
 {
-    const float PI = 3.14159265358979323846f;
-    const float TWO_PI = 2.0f * PI;
+    // Skip wheel labels that are too thin to be drawn at the current size
+    bool wheelLabels = false;
+    if (app.font && !entries.empty()) {
+        int w = 0, h = 0;
+        SDL_GetRenderOutputSize(renderer, &w, &h);
+
+        float cx = 0.0f, cy = 0.0f, radius = 0.0f;
+        wheel_placement(w, h, cx, cy, radius);
+
+        // The widest slice decides whether any label is drawn
+        const double TWO_PI = 2.0 * 3.14159265358979323846;
+        float sliceAngle = static_cast<float>(TWO_PI * entries.max_weight /
+            static_cast<double>(std::max<uint64_t>(entries.total_weight, 1)));
+        wheelLabels = wheel_label_layout(radius, radius * 0.18f, sliceAngle).drawLabels;
+    }
 
-    // ---- Copy entries under mutex so we don't draw while holding the lock ----
-    std::vector<WheelEntry> entriesCopy;
-    {
-        std::lock_guard<std::mutex> lock(app.entries_mutex);
-        entriesCopy = app.entries;
+    // label_cache_clear() drops the handles along with the textures
+    EntryLabels& labels = g_entry_labels;
+    const size_t n = entries.size();
+    if (labels.warmed > n) {
+        labels.warmed = 0;
     }
 
-    int n = static_cast<int>(entriesCopy.size());
-int activeIndex = -1;
-if (app.spinning && n > 0) {
-    activeIndex = pointer_slice_index(app.current_angle, n);
+    labels.wheel.resize(n, nullptr);
+    labels.wheel_dark.resize(n, nullptr);
+    labels.list.resize(n, nullptr);
+
+    const SDL_Color black{ 0, 0, 0, 255 };
+    for (size_t i = labels.warmed; i < n; ++i) {
+        std::string_view name = entries.name(i);
+        if (wheelLabels) {
+            entry_label(renderer, labels.wheel, i, app.font, name,
+                readable_text_color(entries.colors[i]));
+            entry_label(renderer, labels.wheel_dark, i, app.font, name, black);
+        }
+        if (app.list_font && g_text_engine) {
+            entry_list_text(i, app.list_font, name);
+        }
+        else if (app.list_font) {
+            entry_label(renderer, labels.list, i, app.list_font, name, black);
+        }
+    }
+    labels.warmed = n;
 }
 
-  
+static void frame(const TwitchConfig& cfg, float dt)
+{
+    const float PI = 3.14159265358979323846f;
+    const float TWO_PI = 2.0f * PI;
+    const Uint64 frameStart = SDL_GetPerformanceCounter();
+    FrameAllocScope allocScope;
 
     if (app.reset_hold_active) {
         // If for some reason the winner is gone, cancel the hold
@@ -1568,36 +4926,64 @@ if (app.spinning && n > 0) {
             }
         }
     }
-    // ---- Wheel physics (spin, friction, choose winner) ----
-    if (app.spinning && n > 0) {
-        // Advance angle
-        app.current_angle += app.angular_velocity * dt;
 
-        // Wrap angle to [0, 2π) to avoid float blow-up
-        app.current_angle = std::fmod(app.current_angle, TWO_PI);
-        if (app.current_angle < 0.0f) {
-            app.current_angle += TWO_PI;
-        }
+    {
+        ProfScope scope(PROF_ENTRIES);
+
+        // ---- Apply chat commands queued since the last frame ----
+        dispatch_chat_commands(app);
+
+        // ---- Entry snapshot (only re-copied when a join or reset changed it) ----
+        acquire_entries_snapshot(app);
+
+        // ---- Persist what changed since the last frame ----
+        journal_flush(app);
+    }
+    // Keep our own reference for the rest of the frame.
+    std::shared_ptr<const EntryStore> snapshot = app.entries_snapshot;
+    const EntryStore& entriesCopy = *snapshot;
+    const uint64_t entriesVersion = app.snapshot_version;
+
+    int n = static_cast<int>(entriesCopy.size());
+int activeIndex = -1;
+if (app.spinning && n > 0) {
+    activeIndex = pointer_slice_index(app.current_angle, entriesCopy);
+}
 
-        // Apply friction
-        float friction = std::max(0.0f, app.spin_friction);
-        app.angular_velocity -= friction * dt;
+    // ---- Wheel physics (evaluate the solved spin, choose winner) ----
+    if (app.spinning && n > 0) {
+        app.spin_time += dt;
 
-        // If we ran out of speed, stop and pick a winner
-        if (app.angular_velocity <= 0.0f) {
+        if (app.spin_time < app.spin_duration) {
+            // Wrap angle to [0, 2π) to avoid float blow-up
+            app.current_angle = std::fmod(spin_angle_at(app, app.spin_time), TWO_PI);
+            if (app.current_angle < 0.0f) {
+                app.current_angle += TWO_PI;
+            }
+            app.angular_velocity = app.spin_initial_velocity - app.spin_friction * app.spin_time;
+        }
+        // Out of speed: land exactly on the solved angle and take its winner
+        else {
+            app.current_angle = app.spin_final_angle;
             app.angular_velocity = 0.0f;
             app.spinning = false;
 
             if (n > 0) {
-                int idx = pointer_slice_index(app.current_angle, n);
+                // Entries only change mid-spin in odd cases (e.g. the host
+                // re-joining an empty wheel); re-pick for the current slices.
+                int idx = (entriesVersion == app.spin_entries_version)
+                    ? app.spin_winner
+                    : pointer_slice_index(app.current_angle, entriesCopy);
                 if (idx >= 0 && idx < n) {
                     app.winner_index = idx;
 
                     // Winner visual state
                     app.celebration_active = true;
                     app.celebration_time = 0.0f;
-                    app.celebration_name = entriesCopy[idx].name;
-                    app.celebration_color = entriesCopy[idx].color;
+                    std::string_view winner = entriesCopy.name(idx);
+                    app.celebration_name.assign(winner.data(), winner.size());
+                    journal_winner(app.celebration_name);
+                    app.celebration_color = entriesCopy.colors[idx];
                     app.winner_flash_remaining = 2.0f;   // seconds
                     app.winner_flash_elapsed = 0.0f;
                 }
@@ -1610,9 +4996,11 @@ if (app.spinning && n > 0) {
     const float rotSpeed = 60.0f;   // was 10.0f (degrees per second)
 
 
-    app.bg_waka_offset_x += bgSpeed * 0.6f * dt;
-    app.bg_waka_offset_y += bgSpeed * 0.35f * dt;
-    app.bg_waka_angle_deg += rotSpeed * dt;
+    if (app.background_animation) {
+        app.bg_waka_offset_x += bgSpeed * 0.6f * dt;
+        app.bg_waka_offset_y += bgSpeed * 0.35f * dt;
+        app.bg_waka_angle_deg += rotSpeed * dt;
+    }
 
     if (app.bg_waka_angle_deg >= 360.0f)
         app.bg_waka_angle_deg -= 360.0f;
@@ -1654,40 +5042,72 @@ if (app.spinning && n > 0) {
     }
 
     // ---- Rendering ----
-    if (!app.renderer)
+    if (!app.renderer) {
+        prof_discard_frame();
         return;
+    }
+
+    // Nothing visible changed: keep the last presented frame
+    bool animating = scene_animating(app);
+    bool redraw = app.redraw_requested ||
+        animating ||
+        app.last_frame_animating ||      // draw the frame it settled on
+        app.background_animation ||      // the main loop caps this to IDLE_FPS
+        entriesVersion != app.drawn_entries_version;
+    if (!redraw) {
+        prof_discard_frame();
+        return;
+    }
+    app.redraw_requested = false;
+    app.last_frame_animating = animating;
+    app.drawn_entries_version = entriesVersion;
+
+    warm_entry_labels(app.renderer, entriesCopy);
 
     SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 255);
+    prof_count(PROF_DRAW_CALLS);
     SDL_RenderClear(app.renderer);
 
     // Background
-    draw_background(app.renderer,
-        app.waka_texture,
-        app.waka_w,
-        app.waka_h,
-        app.bg_waka_offset_x,
-        app.bg_waka_offset_y,
-        app.bg_waka_angle_deg);
+    {
+        ProfScope scope(PROF_BACKGROUND);
+        draw_background(app.renderer,
+            app.waka_texture,
+            app.waka_w,
+            app.waka_h,
+            app.bg_waka_offset_x,
+            app.bg_waka_offset_y,
+            app.bg_waka_angle_deg,
+            app.background_sprites);
+    }
 
     // Wheel
-    draw_wheel(app.renderer,
-        app.font,
-        entriesCopy,
-        app.current_angle,
-        app.winner_index,
-        app.spinning,
-        winner_flash_on,
-        app.waka_texture,
-        app.waka_w,
-        app.waka_h);
-
-    draw_name_list(app.renderer,
-               app.list_font,
-               entriesCopy,
-               activeIndex,
-               app.winner_index);
+    {
+        ProfScope scope(PROF_WHEEL);
+        draw_wheel(app.renderer,
+            app.font,
+            entriesCopy,
+            entriesVersion,
+            app.current_angle,
+            app.winner_index,
+            app.spinning,
+            winner_flash_on,
+            app.waka_texture,
+            app.waka_w,
+            app.waka_h);
+    }
+
+    {
+        ProfScope scope(PROF_NAME_LIST);
+        draw_name_list(app.renderer,
+                   app.list_font,
+                   entriesCopy,
+                   activeIndex,
+                   app.winner_index);
+    }
      // Status text / help: top-center rounded container
     {
+        ProfScope hudScope(PROF_HUD);
         // Prefer status_font, fall back to list_font if needed
         TTF_Font* f = app.status_font ? app.status_font : app.list_font;
         if (f && app.renderer) {
@@ -1696,7 +5116,7 @@ if (app.spinning && n > 0) {
 
             bool isOpen = app.join_open.load();
 
-            std::string statusText = isOpen
+            const char* statusText = isOpen
                 ? "Type !join in chat to join the Wheel"
                 : "Wheel is now closed";
 
@@ -1711,63 +5131,57 @@ if (app.spinning && n > 0) {
 
             SDL_Color borderColor{ 0, 0, 0, 255 };
 
-            SDL_Surface* surface =
-                TTF_RenderText_Blended(f, statusText.c_str(), 0, textColor);
-            if (surface) {
-                SDL_Texture* texture =
-                    SDL_CreateTextureFromSurface(app.renderer, surface);
-                if (texture) {
-                    float textW = static_cast<float>(surface->w);
-                    float textH = static_cast<float>(surface->h);
-
-                    // Padding around text inside the card
-                    float paddingX = 18.0f;
-                    float paddingY = 8.0f;
-
-                    float cardW = textW + paddingX * 2.0f;
-                    float cardH = textH + paddingY * 2.0f;
-
-                    // Centered horizontally, near the top (same Y as before)
-                    float centerX = winW * 0.5f;
-                    float centerY = winH * 0.07f;
-
-                    float cardX = centerX - cardW * 0.5f;
-                    float cardY = centerY - cardH * 0.5f;
-
-                    float outerRadius      = 12.0f;
-                    float innerRadius      = 10.0f;
-                    float borderThickness  = 2.0f;
-
-                    // Outer border
-                    draw_filled_rounded_rect(app.renderer,
-                        cardX,
-                        cardY,
-                        cardW,
-                        cardH,
-                        outerRadius,
-                        borderColor);
-
-                    // Inner fill
-                    draw_filled_rounded_rect(app.renderer,
-                        cardX + borderThickness,
-                        cardY + borderThickness,
-                        cardW - borderThickness * 2.0f,
-                        cardH - borderThickness * 2.0f,
-                        innerRadius,
-                        fillColor);
-
-                    // Render text inside
-                    SDL_FRect dst{};
-                    dst.w = textW;
-                    dst.h = textH;
-                    dst.x = cardX + paddingX;
-                    dst.y = cardY + paddingY;
-
-                    SDL_RenderTexture(app.renderer, texture, nullptr, &dst);
-
-                    SDL_DestroyTexture(texture);
-                }
-                SDL_DestroySurface(surface);
+            const TextWidget* text = text_widget_update(app.renderer, g_status_text,
+                f, statusText, textColor);
+            if (text) {
+                float textW = text->w;
+                float textH = text->h;
+
+                // Padding around text inside the card
+                float paddingX = 18.0f;
+                float paddingY = 8.0f;
+
+                float cardW = textW + paddingX * 2.0f;
+                float cardH = textH + paddingY * 2.0f;
+
+                // Centered horizontally, near the top (same Y as before)
+                float centerX = winW * 0.5f;
+                float centerY = winH * 0.07f;
+
+                float cardX = centerX - cardW * 0.5f;
+                float cardY = centerY - cardH * 0.5f;
+
+                float outerRadius      = 12.0f;
+                float innerRadius      = 10.0f;
+                float borderThickness  = 2.0f;
+
+                // Outer border
+                draw_filled_rounded_rect(app.renderer,
+                    cardX,
+                    cardY,
+                    cardW,
+                    cardH,
+                    outerRadius,
+                    borderColor);
+
+                // Inner fill
+                draw_filled_rounded_rect(app.renderer,
+                    cardX + borderThickness,
+                    cardY + borderThickness,
+                    cardW - borderThickness * 2.0f,
+                    cardH - borderThickness * 2.0f,
+                    innerRadius,
+                    fillColor);
+
+                // Render text inside
+                SDL_FRect dst{};
+                dst.w = textW;
+                dst.h = textH;
+                dst.x = cardX + paddingX;
+                dst.y = cardY + paddingY;
+
+                prof_count(PROF_DRAW_CALLS);
+                SDL_RenderTexture(app.renderer, text->texture, nullptr, &dst);
             }
         }
     }
@@ -1775,8 +5189,9 @@ if (app.spinning && n > 0) {
 
     // Winner banner overlay
     if (app.celebration_active && !app.celebration_name.empty()) {
+        ProfScope scope(PROF_BANNER);
         draw_winner_banner(app.renderer,
-            app.status_font ? app.status_font : app.font,
+            winner_banner_font(app),
             app.celebration_name,
             app.celebration_color,
             app.celebration_time);
@@ -1785,10 +5200,11 @@ if (app.spinning && n > 0) {
 
     // Hold-to-reset message in lower-right corner
     if (app.reset_hold_active && (app.status_font || app.font)) {
+        ProfScope hudScope(PROF_HUD);
         int winW = 0, winH = 0;
         SDL_GetRenderOutputSize(app.renderer, &winW, &winH);
 
-        std::string msg = "hold for one second to reset...";
+        const char* msg = "hold for one second to reset...";
         TTF_Font* f = app.status_font ? app.status_font : app.font;
         if (!f) {
             // Shouldn't happen, but bail out safely if it does
@@ -1796,105 +5212,154 @@ if (app.spinning && n > 0) {
             return;
         }
 
-        // Render once to measure text
         SDL_Color white{ 255, 255, 255, 255 };
-        SDL_Surface* surface = TTF_RenderText_Blended(f, msg.c_str(), 0, white);
-        if (surface) {
-            SDL_Texture* texture = SDL_CreateTextureFromSurface(app.renderer, surface);
-            if (texture) {
-                float textW = static_cast<float>(surface->w);
-                float textH = static_cast<float>(surface->h);
-
-                // Card padding and size
-                float paddingX = 16.0f;
-                float paddingY = 8.0f;
-                float cardW = textW + paddingX * 2.0f;
-                float cardH = textH + paddingY * 2.0f;
-
-                float margin = 24.0f;
-
-                // Final position (bottom-right corner with margin)
-                float finalX = static_cast<float>(winW) - margin - cardW;
-                float finalY = static_cast<float>(winH) - margin - cardH;
-
-                // Start position: fully off-screen to the right
-                float startX = static_cast<float>(winW) + cardW;
-
-                // Slide-in over 0.15 seconds
-                const float slideInDuration = 0.15f;
-                float t = app.reset_hold_elapsed;
-                if (t < 0.0f) t = 0.0f;
-                if (t > slideInDuration) t = slideInDuration;
-
-                float p = (slideInDuration > 0.0f)
-                    ? (t / slideInDuration)
-                    : 1.0f;
-
-                // Use existing easing helper for a quick, smooth slide
-                p = ease_out_cubic(p);
-
-                float currentX = startX + (finalX - startX) * p;
-                float currentY = finalY;
-
-                // Draw rounded card: white border + black fill
-                SDL_Color borderColor{ 255, 255, 255, 255 };
-                SDL_Color fillColor{ 0, 0, 0, 255 };
-
-                float outerRadius = 10.0f;
-                float innerRadius = 8.0f;
-                float borderThickness = 2.0f;
-
-                // Outer (border)
-                draw_filled_rounded_rect(app.renderer,
-                    currentX,
-                    currentY,
-                    cardW,
-                    cardH,
-                    outerRadius,
-                    borderColor);
-
-                // Inner (fill), inset by border thickness
-                draw_filled_rounded_rect(app.renderer,
-                    currentX + borderThickness,
-                    currentY + borderThickness,
-                    cardW - borderThickness * 2.0f,
-                    cardH - borderThickness * 2.0f,
-                    innerRadius,
-                    fillColor);
-
-                // Draw text inside the card, in white
-                SDL_FRect dst{};
-                dst.w = textW;
-                dst.h = textH;
-                dst.x = currentX + paddingX;
-                dst.y = currentY + paddingY;
-
-                SDL_RenderTexture(app.renderer, texture, nullptr, &dst);
-
-                SDL_DestroyTexture(texture);
-            }
-
-            SDL_DestroySurface(surface);
+        const TextWidget* text = text_widget_update(app.renderer, g_hold_text,
+            f, msg, white);
+        if (text) {
+            float textW = text->w;
+            float textH = text->h;
+
+            // Card padding and size
+            float paddingX = 16.0f;
+            float paddingY = 8.0f;
+            float cardW = textW + paddingX * 2.0f;
+            float cardH = textH + paddingY * 2.0f;
+
+            float margin = 24.0f;
+
+            // Final position (bottom-right corner with margin)
+            float finalX = static_cast<float>(winW) - margin - cardW;
+            float finalY = static_cast<float>(winH) - margin - cardH;
+
+            // Start position: fully off-screen to the right
+            float startX = static_cast<float>(winW) + cardW;
+
+            // Slide-in over 0.15 seconds
+            const float slideInDuration = 0.15f;
+            float t = app.reset_hold_elapsed;
+            if (t < 0.0f) t = 0.0f;
+            if (t > slideInDuration) t = slideInDuration;
+
+            float p = (slideInDuration > 0.0f)
+                ? (t / slideInDuration)
+                : 1.0f;
+
+            // Use existing easing helper for a quick, smooth slide
+            p = ease_out_cubic(p);
+
+            float currentX = startX + (finalX - startX) * p;
+            float currentY = finalY;
+
+            // Draw rounded card: white border + black fill
+            SDL_Color borderColor{ 255, 255, 255, 255 };
+            SDL_Color fillColor{ 0, 0, 0, 255 };
+
+            float outerRadius = 10.0f;
+            float innerRadius = 8.0f;
+            float borderThickness = 2.0f;
+
+            // Outer (border)
+            draw_filled_rounded_rect(app.renderer,
+                currentX,
+                currentY,
+                cardW,
+                cardH,
+                outerRadius,
+                borderColor);
+
+            // Inner (fill), inset by border thickness
+            draw_filled_rounded_rect(app.renderer,
+                currentX + borderThickness,
+                currentY + borderThickness,
+                cardW - borderThickness * 2.0f,
+                cardH - borderThickness * 2.0f,
+                innerRadius,
+                fillColor);
+
+            // Draw text inside the card, in white
+            SDL_FRect dst{};
+            dst.w = textW;
+            dst.h = textH;
+            dst.x = currentX + paddingX;
+            dst.y = currentY + paddingY;
+
+            prof_count(PROF_DRAW_CALLS);
+            SDL_RenderTexture(app.renderer, text->texture, nullptr, &dst);
         }
     }
 
+    if (g_prof.overlay) {
+        draw_profiler_overlay(app.renderer);
+    }
 
-    SDL_RenderPresent(app.renderer);
+    {
+        ProfScope scope(PROF_PRESENT);
+        SDL_RenderPresent(app.renderer);
+    }
+    prof_add(PROF_FRAME, frameStart);
+    prof_count(PROF_HEAP_ALLOCS, static_cast<uint32_t>(t_alloc_count));
+    prof_end_frame();
 }
 
 
 #ifdef __EMSCRIPTEN__
 extern "C" {
 
+    // A leading '*' marks a subscriber (Twitch names can't contain one).
+    static bool take_subscriber_mark(std::string_view& name) {
+        if (name.empty() || name[0] != '*') return false;
+        name.remove_prefix(1);
+        return true;
+    }
+
+    // Chat commands from the page go through the same dispatcher as
+    // native chat (see "Chat commands") and take effect next frame.
+    static void queue_page_command(CommandKind kind, std::string_view name) {
+        ChatCommand cmd;
+        cmd.kind = kind;
+        cmd.subscriber = kind == CommandKind::Join && take_subscriber_mark(name);
+        cmd.name.assign(name.data(), name.size());
+        queue_chat_command(app, std::move(cmd));
+    }
+
     EMSCRIPTEN_KEEPALIVE
         void wheel_join(const char* user) {
         if (!user || !user[0]) return;
-        if (app.join_open.load() || (app.entries.empty() && g_twitch_cfg.nick == user)) {
-            add_player_if_new(user, app.entries, app.entries_mutex);
+        queue_page_command(CommandKind::Join, user);
+    }
+
+    // Many joins in one call: `packed` holds `len` bytes of '\n'-separated
+    // names (not NUL-terminated), written straight into WASM memory by JS.
+    EMSCRIPTEN_KEEPALIVE
+        void wheel_join_batch(const char* packed, int len) {
+        if (!packed || len <= 0) return;
+
+        std::string_view rest(packed, static_cast<size_t>(len));
+        while (!rest.empty()) {
+            size_t nl = rest.find('\n');
+            std::string_view name = rest.substr(0, nl);
+            rest = (nl == std::string_view::npos) ? std::string_view() : rest.substr(nl + 1);
+            if (!name.empty()) {
+                queue_page_command(CommandKind::Join, name);
+            }
         }
     }
 
     
+    // Round history (see winner_history_text); empty until a spin ends
+    EMSCRIPTEN_KEEPALIVE
+    const char* wheel_history() {
+        static std::string history;
+        history = winner_history_text();
+        return history.c_str();
+    }
+
+    // Called once IDBFS has loaded /data from IndexedDB (see main)
+    EMSCRIPTEN_KEEPALIVE
+    void wheel_journal_ready() {
+        journal_open(app, "/data/wheel.journal");
+    }
+
     // Called from JS to tell the C++ side who the channel owner is
     EMSCRIPTEN_KEEPALIVE
     void wheel_set_host(const char* nick, const char* channel) {
@@ -1906,58 +5371,364 @@ extern "C" {
     }
 
 
+    // `user` is the chat sender, for the per-user limits; may be null.
     EMSCRIPTEN_KEEPALIVE
-        void wheel_reset() {
-            {
-                // Clear wheel + winner state
-                std::lock_guard<std::mutex> lock(app.entries_mutex);
-                app.entries.clear();
-                app.join_open.store(false); // CLOSED
-                app.spinning = false;
-                app.angular_velocity = 0.0f;
-                app.winner_index = -1;
-                app.celebration_active = false;
-                app.celebration_time = 0.0f;
-                app.celebration_name.clear();
-            }
+        void wheel_reset(const char* user) {
+        queue_page_command(CommandKind::Reset, user ? user : "");
+    }
 
-            // Re-add the channel owner as the first entry (if configured)
-            if (!g_twitch_cfg.nick.empty()) {
-                add_player_if_new(g_twitch_cfg.nick, app.entries, app.entries_mutex);
-            }
+    EMSCRIPTEN_KEEPALIVE
+        void wheel_spin(const char* user) {
+        queue_page_command(CommandKind::Spin, user ? user : "");
+    }
+
+    // The last spin's seed, entry hash and start angle (see "Spins"), for
+    // viewers to check the draw or a second overlay to replay it.
+    EMSCRIPTEN_KEEPALIVE
+    const char* wheel_spin_record() {
+        static std::string record;
+        std::lock_guard<std::mutex> lock(app.entries_mutex);
+        record = spin_record(app);
+        return record.c_str();
     }
 
+    // Replay a published spin: 64-bit values arrive as hi/lo halves. Only
+    // starts if this wheel holds the same entries (by hash) and could spin
+    // now; returns 1 if it did.
     EMSCRIPTEN_KEEPALIVE
-        void wheel_spin() {
+    int wheel_spin_seeded(uint32_t seed_hi, uint32_t seed_lo,
+        uint32_t hash_hi, uint32_t hash_lo, float start_angle) {
         std::lock_guard<std::mutex> lock(app.entries_mutex);
+        if (app.entries.size() < 2 || app.spinning || app.join_open.load()) return 0;
+
+        uint64_t hash = (static_cast<uint64_t>(hash_hi) << 32) | hash_lo;
+        if (entries_hash(app.entries) != hash) {
+            log_warn("[Wheel] Seeded spin skipped: entries differ (hash %016llx)",
+                static_cast<unsigned long long>(hash));
+            return 0;
+        }
+        app.current_angle = start_angle;
+        start_spin_seeded_locked(app, (static_cast<uint64_t>(seed_hi) << 32) | seed_lo);
+        return 1;
+    }
+
+} // extern "C"
+#endif
+
+
+
+// ----------------------
+// Asset loading
+// ----------------------
+
+// Fonts and the waka sprite are read off the main thread (native) or
+// fetched one by one (web) while the first frames already show the
+// background and a bare wheel. assets_poll() turns each file into fonts or
+// a texture on the main thread as it lands, so TTF and renderer calls stay
+// there. Idle frames then pre-rasterize the HUD glyphs.
+//
+// The web build should fetch only these files, served next to wheel.js
+// under assets/, instead of --preload-file'ing the whole assets/ tree
+// (Default.ttf and assets/data/*.json aren't used by the wheel). The
+// fallback font is optional; a 404 just means names in scripts the main
+// fonts don't cover render as boxes.
+enum AssetId {
+    ASSET_WHEEL_FONT,   // wheel labels + status / banner text
+    ASSET_LIST_FONT,    // name list
+    ASSET_FALLBACK_FONT,// optional, glyphs the other fonts lack
+    ASSET_WAKA,         // background, hub and banner sprite
+    ASSET_COUNT
+};
 
-        if (app.entries.size() < 2 || app.spinning) return;
+enum AssetState : int { ASSET_PENDING, ASSET_LOADED, ASSET_FAILED };
 
-        if (app.join_open.load()) return; // cannot spin while OPEN
+struct AssetFile {
+    const char*      path = nullptr;
+    void*            data = nullptr;   // SDL_malloc'd; fonts keep reading from it
+    size_t           size = 0;
+    std::atomic<int> state{ ASSET_PENDING };
+    bool             applied = false;  // consumed by assets_poll()
+};
 
+struct AssetLoader {
+    AssetFile   files[ASSET_COUNT];
+    bool        started = false;
+    bool        failed = false;        // a required asset is missing
+    bool        fallback_attached = false;
+    std::vector<TTF_Font*> fallbacks;  // one per main font, closed after them
+    int         warm_step = 0;         // next HUD glyph warm-up (see warm_hud_glyphs)
+#ifndef __EMSCRIPTEN__
+    std::thread thread;
+#endif
+};
 
-        app.spinning = true;
-        app.winner_index = -1;
-        app.winner_flash_remaining = 0.0f;
-        app.winner_flash_elapsed = 0.0f;
+static AssetLoader g_assets;
 
-        std::uniform_real_distribution<float> spinSpeed(10.0f, 13.0f);
-        std::uniform_real_distribution<float> spinFriction(1.8f, 5.6f);
+static void asset_read(AssetFile& f) {
+    size_t size = 0;
+    void* data = SDL_LoadFile(f.path, &size);
+    f.data = data;
+    f.size = size;
+    f.state.store(data ? ASSET_LOADED : ASSET_FAILED, std::memory_order_release);
+}
 
-        app.spin_friction = spinFriction(global_rng());
-        app.angular_velocity = spinSpeed(global_rng());
+#ifdef __EMSCRIPTEN__
+static void asset_fetched(void* arg, void* buffer, int size) {
+    AssetFile& f = *static_cast<AssetFile*>(arg);
+    // The buffer is freed when we return
+    f.data = SDL_malloc(static_cast<size_t>(size));
+    if (f.data) {
+        std::memcpy(f.data, buffer, static_cast<size_t>(size));
+        f.size = static_cast<size_t>(size);
     }
+    f.state.store(f.data ? ASSET_LOADED : ASSET_FAILED, std::memory_order_release);
+}
 
-} // extern "C"
+static void asset_fetch_failed(void* arg) {
+    static_cast<AssetFile*>(arg)->state.store(ASSET_FAILED, std::memory_order_release);
+}
+#endif
+
+// Start reading every asset. When `blocking` is set the files are read
+// before this returns (the benchmark wants a fully loaded first frame).
+static void assets_start(bool blocking) {
+    AssetLoader& l = g_assets;
+    if (l.started) return;
+    l.started = true;
+    l.files[ASSET_WHEEL_FONT].path = FONT_PATH;
+    l.files[ASSET_LIST_FONT].path = LIST_FONT_PATH;
+    l.files[ASSET_FALLBACK_FONT].path = FALLBACK_FONT_PATH;
+    l.files[ASSET_WAKA].path = WAKA_PATH;
+
+    if (blocking) {
+        for (AssetFile& f : l.files) asset_read(f);
+        return;
+    }
+#ifdef __EMSCRIPTEN__
+    for (AssetFile& f : l.files) {
+        emscripten_async_wget_data(f.path, &f, asset_fetched, asset_fetch_failed);
+    }
+#else
+    l.thread = std::thread([] {
+        for (AssetFile& f : g_assets.files) asset_read(f);
+    });
+#endif
+}
+
+static bool assets_pending() {
+    for (const AssetFile& f : g_assets.files) {
+        if (!f.applied) return true;
+    }
+    return false;
+}
+
+static TTF_Font* open_font_from_asset(const AssetFile& f, float size) {
+    TTF_Font* font = TTF_OpenFontIO(SDL_IOFromConstMem(f.data, f.size), true, size);
+    if (font) {
+        TTF_SetFontHinting(font, TTF_HINTING_LIGHT);
+    }
+    return font;
+}
+
+static void apply_asset(AppState& a, AssetId id, AssetFile& f) {
+    bool loaded = f.state.load(std::memory_order_acquire) == ASSET_LOADED;
+    if (!loaded && id == ASSET_FALLBACK_FONT) {
+        log_info("[Assets] No fallback font at '%s'; glyphs the main fonts lack won't show",
+            f.path);
+    }
+    else if (!loaded) {
+        log_error("[Assets] Could not load '%s': %s", f.path, SDL_GetError());
+    }
+
+    switch (id) {
+    case ASSET_WHEEL_FONT:
+        a.font = loaded ? open_font_from_asset(f, WHEEL_FONT_SIZE) : nullptr;
+        if (!a.font) {
+            if (loaded) {
+                log_error("[Assets] TTF_OpenFont failed for '%s': %s", f.path, SDL_GetError());
+            }
+            g_assets.failed = true; // the wheel can't run without it
+            break;
+        }
+        a.status_font = open_font_from_asset(f, STATUS_FONT_SIZE);
+        if (!a.status_font) {
+            a.status_font = a.font;
+        }
+        break;
+
+    case ASSET_LIST_FONT:
+        a.list_font = loaded ? open_font_from_asset(f, LIST_FONT_SIZE) : nullptr;
+        break;
+
+    case ASSET_FALLBACK_FONT:
+        // Attached by attach_fallback_fonts() once the main fonts exist
+        if (!loaded) {
+            SDL_free(f.data);
+            f.data = nullptr;
+        }
+        break;
+
+    case ASSET_WAKA:
+        // Optional; draws simply skip the sprite without it
+        if (loaded && a.renderer) {
+            prof_count(PROF_TEXTURES_CREATED);
+            a.waka_texture = IMG_LoadTexture_IO(a.renderer,
+                SDL_IOFromConstMem(f.data, f.size), true);
+            if (!a.waka_texture) {
+                log_error("[Assets] IMG_LoadTexture failed: %s", SDL_GetError());
+            }
+            else {
+                SDL_SetTextureScaleMode(a.waka_texture, SDL_SCALEMODE_NEAREST);
+
+                float tw = 0.0f, th = 0.0f;
+                if (SDL_GetTextureSize(a.waka_texture, &tw, &th)) {
+                    a.waka_w = static_cast<int>(tw);
+                    a.waka_h = static_cast<int>(th);
+                }
+            }
+        }
+        // The texture holds its own copy of the pixels
+        SDL_free(f.data);
+        f.data = nullptr;
+        break;
+
+    default:
+        break;
+    }
+    f.applied = true;
+}
+
+// Give every main font a same-size instance of the fallback font, once
+// the fallback and both main font files have been applied.
+static void attach_fallback_fonts(AppState& a) {
+    AssetLoader& l = g_assets;
+    const AssetFile& f = l.files[ASSET_FALLBACK_FONT];
+    if (l.fallback_attached || !f.applied || !f.data ||
+        !l.files[ASSET_WHEEL_FONT].applied || !l.files[ASSET_LIST_FONT].applied) {
+        return;
+    }
+    l.fallback_attached = true;
+
+    struct { TTF_Font* font; float size; } targets[] = {
+        { a.font, WHEEL_FONT_SIZE },
+        { a.status_font != a.font ? a.status_font : nullptr, STATUS_FONT_SIZE },
+        { a.list_font, LIST_FONT_SIZE },
+    };
+    for (const auto& t : targets) {
+        if (!t.font) continue;
+        TTF_Font* fallback = open_font_from_asset(f, t.size);
+        if (fallback && TTF_AddFallbackFont(t.font, fallback)) {
+            l.fallbacks.push_back(fallback);
+        }
+        else if (fallback) {
+            TTF_CloseFont(fallback);
+        }
+    }
+}
+
+// Main thread, once per frame: build fonts / textures from files that
+// finished loading. Returns false once a required asset has failed.
+static bool assets_poll(AppState& a) {
+    AssetLoader& l = g_assets;
+    bool fontsChanged = false;
+    bool changed = false;
+    for (int id = 0; id < ASSET_COUNT; ++id) {
+        AssetFile& f = l.files[id];
+        if (f.applied || f.state.load(std::memory_order_acquire) == ASSET_PENDING) {
+            continue;
+        }
+        apply_asset(a, static_cast<AssetId>(id), f);
+        fontsChanged |= (id != ASSET_WAKA);
+        changed = true;
+    }
+    if (fontsChanged) {
+        attach_fallback_fonts(a);
+        // Anything rasterized so far was drawn without these fonts
+        label_cache_clear();
+    }
+    if (changed) {
+        wheel_texture_invalidate();
+        a.redraw_requested = true;
+    }
+#ifndef __EMSCRIPTEN__
+    if (l.thread.joinable() && !assets_pending()) {
+        l.thread.join();
+    }
 #endif
+    return !l.failed;
+}
+
+// Read and apply everything now (the benchmark, and anything else that
+// can't draw a partial first frame). Returns false if the wheel font is
+// missing.
+static bool assets_load_blocking(AppState& a) {
+    assets_start(true);
+    return assets_poll(a);
+}
 
+// Idle frames: rasterize the printable ASCII range once per font so the
+// first status / banner / hold text doesn't pay for glyph loading. One
+// font per call.
+static void warm_hud_glyphs(AppState& a) {
+    if (assets_pending()) return;
+
+    static const char GLYPHS[] =
+        " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+        "[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+    TTF_Font* fonts[] = { a.status_font, a.font, a.list_font };
+    int& step = g_assets.warm_step;
+    while (step < static_cast<int>(SDL_arraysize(fonts))) {
+        TTF_Font* f = fonts[step++];
+        bool seen = false;
+        for (int i = 0; i + 1 < step; ++i) seen |= (fonts[i] == f);
+        if (!f || seen) continue;
+
+        prof_count(PROF_TTF_RENDERS);
+        if (SDL_Surface* s = TTF_RenderText_Blended(f, GLYPHS, 0, SDL_Color{ 255, 255, 255, 255 })) {
+            SDL_DestroySurface(s);
+        }
+        return;
+    }
+}
+
+// Close fonts before releasing the memory they read from.
+static void assets_release(AppState& a) {
+#ifndef __EMSCRIPTEN__
+    if (g_assets.thread.joinable()) {
+        g_assets.thread.join();
+    }
+#endif
+    if (a.status_font && a.status_font != a.font) {
+        TTF_CloseFont(a.status_font);
+    }
+    if (a.font) {
+        TTF_CloseFont(a.font);
+    }
+    if (a.list_font) {
+        TTF_CloseFont(a.list_font);
+    }
+    a.font = a.status_font = a.list_font = nullptr;
+    for (TTF_Font* fallback : g_assets.fallbacks) {
+        TTF_CloseFont(fallback);
+    }
+    g_assets.fallbacks.clear();
+    for (AssetFile& f : g_assets.files) {
+        SDL_free(f.data);
+        f.data = nullptr;
+    }
+}
 
 
 // ----------------------
 // Main
 // ----------------------
 
+// src/bench.cpp includes this file with SHOEPEWHEEL_NO_MAIN defined and
+// supplies its own main().
+#ifndef SHOEPEWHEEL_NO_MAIN
 int main(int /*argc*/, char** /*argv*/) {
+    install_alloc_counting();
 
 #ifdef _WIN32
     // Use the icon embedded in the .exe via your .rc file
@@ -1965,13 +5736,12 @@ int main(int /*argc*/, char** /*argv*/) {
     SDL_SetHint(SDL_HINT_WINDOWS_INTRESOURCE_ICON_SMALL, "101");
 #endif
 
-    SDL_SetRenderVSync(app.renderer, 1);
-
 // SDL3: returns true on success, false on failure
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "SDL_Init failed: " << SDL_GetError() << "\n";
         return 1;
     }
+    g_wake_event = SDL_RegisterEvents(1);
 
     // SDL3_ttf: returns true on success, false on failure
     if (!TTF_Init()) {
@@ -1979,31 +5749,6 @@ int main(int /*argc*/, char** /*argv*/) {
         SDL_Quit();
         return 1;
     }
-    app.font = TTF_OpenFont(FONT_PATH, 34.0f);
-    if (!app.font) {
-        std::cerr << "TTF_OpenFont failed for '" << FONT_PATH
-            << "': " << SDL_GetError() << "\n";
-        TTF_Quit();
-        SDL_Quit();
-        return 1;
-    }
-
-    app.status_font = TTF_OpenFont(FONT_PATH, 26.0f);
-    if (!app.status_font) {
-        app.status_font = app.font;
-    }
-    if (app.font) {
-        TTF_SetFontHinting(app.font, TTF_HINTING_LIGHT);
-    }
-    if (app.status_font && app.status_font != app.font) {
-        TTF_SetFontHinting(app.status_font, TTF_HINTING_LIGHT);
-    }
-
-    app.list_font = TTF_OpenFont(LIST_FONT_PATH, 15.0f);
-    if (app.list_font) {
-        TTF_SetFontHinting(app.list_font, TTF_HINTING_LIGHT);
-    }
-
     int windowWidth = 940;
     int windowHeight = 720;
 
@@ -2020,21 +5765,14 @@ int main(int /*argc*/, char** /*argv*/) {
     }
 
     SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+    // Full-rate frames are paced by vsync; idle ones by idle_wait_ms()
+    SDL_SetRenderVSync(app.renderer, 1);
 
-    // SDL3_image: no IMG_Init / IMG_Quit needed in current versions
-    app.waka_texture = IMG_LoadTexture(app.renderer, "assets/images/waka.png");
-    if (!app.waka_texture) {
-        std::cerr << "IMG_LoadTexture failed: " << SDL_GetError() << "\n";
-    }
-    else {
-        SDL_SetTextureScaleMode(app.waka_texture, SDL_SCALEMODE_NEAREST);
+    text_engine_open(app.renderer);
 
-        float tw = 0.0f, th = 0.0f;
-        if (SDL_GetTextureSize(app.waka_texture, &tw, &th)) {
-            app.waka_w = static_cast<int>(tw);
-            app.waka_h = static_cast<int>(th);
-        }
-    }
+    // Fonts and the waka load while the first frames draw
+    assets_start(false);
+    workers_start();
 
 
     // Hardcoded test entries so you can see the wheel without Twitch
@@ -2056,23 +5794,35 @@ int main(int /*argc*/, char** /*argv*/) {
         };
 
 
-        app.entries.clear();
-        app.entries.reserve(std::size(names));
+        clear_entries_locked(app);
 
         for (const char* n : names) {
-            app.entries.push_back(WheelEntry{ n, random_color() });
+            add_player_locked(app, n);
         }
             
     }
   */
 
     
+    log_start();
+
     TwitchConfig& cfg = g_twitch_cfg;
 #ifndef __EMSCRIPTEN__
     load_twitch_config("twitch.cfg", cfg);
+    init_channel_stats(app, cfg.channels);
+    app.background_animation = cfg.animate_background;
+    app.background_sprites = cfg.background_sprites;
+    app.sub_tickets = static_cast<uint32_t>(cfg.sub_tickets);
+    app.max_tickets = static_cast<uint32_t>(std::max(cfg.max_tickets, cfg.sub_tickets));
+    app.command_window_ms = static_cast<uint32_t>(cfg.command_window_ms);
+    app.user_commands_per_min = static_cast<uint32_t>(cfg.user_commands_per_min);
+    app.commands_per_sec = static_cast<uint32_t>(cfg.commands_per_sec);
+    app.seeded_spins = cfg.seeded_spins;
+    app.spin_seed_state = cfg.spin_seed;
+    journal_open(app, cfg.journal);
     app.authorized = is_stream_allowed(cfg.nick, cfg.channel);
     if (!cfg.nick.empty()) {
-        add_player_if_new(cfg.nick, app.entries, app.entries_mutex);
+        add_player_if_new(app, cfg.nick);
     }
 
     // Start Twitch thread (only if configured)
@@ -2083,15 +5833,36 @@ int main(int /*argc*/, char** /*argv*/) {
             !cfg.nick.empty() &&
             !cfg.channel.empty());
 
+    IrcWaker          twitchWaker;
+
+    if (twitchEnabled) {
+        twitchEnabled = net_startup();
+        if (twitchEnabled && !irc_waker_open(twitchWaker)) {
+            log_error("[Twitch] Could not create wake-up socket: %d", net_last_error());
+            net_cleanup();
+            twitchEnabled = false;
+        }
+    }
+
     if (twitchEnabled) {
         twitchRunning = true;
         twitchThread = std::thread(
             twitch_chat_thread,
             cfg,
             std::ref(twitchRunning),
-            std::ref(app.entries),
-            std::ref(app.entries_mutex));
+            std::cref(twitchWaker),
+            std::ref(app));
     }
+#else
+    // The journal lives in IndexedDB; replay it once IDBFS has loaded
+    EM_ASM({
+        FS.mkdir('/data');
+        FS.mount(IDBFS, {}, '/data');
+        FS.syncfs(true, function(err) {
+            if (err) console.error('journal load failed', err);
+            Module._wheel_journal_ready();
+        });
+    });
 #endif
 
 
@@ -2107,11 +5878,26 @@ int main(int /*argc*/, char** /*argv*/) {
 
             SDL_Event e;
             while (SDL_PollEvent(&e)) {
+                note_event_for_redraw(app, e);
+                if (name_list_handle_event(app, e)) continue;
                 if (e.type == SDL_EVENT_QUIT) {
                     // ignored in browser
                 }
+                else if (e.type == SDL_EVENT_RENDER_TARGETS_RESET) {
+                    wheel_texture_invalidate();
+                    name_list_invalidate();
+                }
                 else if (e.type == SDL_EVENT_KEY_DOWN) {
-                    if (e.key.key == SDLK_SPACE) {
+                    if (prof_handle_key(e.key.key)) {
+                        // profiler overlay / CSV dump
+                    }
+                    else if (e.key.key == SDLK_F5) {
+                        log_winner_history();
+                    }
+                    else if (e.key.key == SDLK_B) {
+                        toggle_background_animation(app);
+                    }
+                    else if (e.key.key == SDLK_SPACE) {
                         bool isOpen = app.join_open.load();
                         if (isOpen) {
                             // When OPEN, ignore spin/reset input.
@@ -2165,12 +5951,12 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
 
         if (winnerShowing) {
             // After a winner is selected, right-click open/close toggle is disabled.
-            std::cout << "[Wheel] Join toggle ignored (winner selected)\n";
+            log_info("[Wheel] Join toggle ignored (winner selected)");
         } else {
             bool current = app.join_open.load();
             app.join_open.store(!current);
-            std::cout << "[Wheel] Join state toggled to "
-                      << (app.join_open.load() ? "OPEN" : "CLOSED") << "\n";
+            log_info("[Wheel] Join state toggled to %s",
+                     app.join_open.load() ? "OPEN" : "CLOSED");
         }
     }
 }
@@ -2188,6 +5974,14 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
 
             static Uint64 last = SDL_GetTicks();
             Uint64 now = SDL_GetTicks();
+
+            // The browser calls us every animation frame; skip the ones
+            // frame pacing says aren't due.
+            assets_poll(app);
+            if (idle_wait_ms(app, now - last) > 0) {
+                warm_hud_glyphs(app);
+                return;
+            }
             float dt = static_cast<float>(now - last) / 1000.0f;
             last = now;
 
@@ -2199,16 +5993,42 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
     );
 #else
         while (!quit) {
+        // Idle: sleep until input, a chat join or the next idle frame
+        if (!assets_poll(app)) {
+            break; // no wheel font
+        }
+        int waitMs = idle_wait_ms(app, SDL_GetTicks() - lastTicks);
+        if (waitMs > 0) {
+            warm_hud_glyphs(app);
+            idle_wait(app, waitMs);
+        }
+
         while (SDL_PollEvent(&e)) {
+            note_event_for_redraw(app, e);
+            if (name_list_handle_event(app, e)) continue;
             if (e.type == SDL_EVENT_QUIT) {
                 quit = true;
             }
+            else if (e.type == SDL_EVENT_RENDER_TARGETS_RESET) {
+                // Render target contents are gone; rebuild on next use
+                wheel_texture_invalidate();
+                name_list_invalidate();
+            }
             else if (e.type == SDL_EVENT_KEY_DOWN) {
                 SDL_Keycode key = e.key.key;
 
                 if (key == SDLK_ESCAPE) {
                     quit = true;
                 }
+                else if (prof_handle_key(key)) {
+                    // profiler overlay / CSV dump
+                }
+                else if (key == SDLK_F5) {
+                    log_winner_history();
+                }
+                else if (key == SDLK_B) {
+                    toggle_background_animation(app);
+                }
                 else if (key == SDLK_SPACE) {
                     bool winnerShowing =
                         (app.celebration_active || app.winner_index >= 0);
@@ -2253,8 +6073,8 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
     else if (e.button.button == SDL_BUTTON_RIGHT) {
         bool current = app.join_open.load();
         app.join_open.store(!current);
-        std::cout << "[Wheel] Join state toggled to "
-                  << (app.join_open.load() ? "OPEN" : "CLOSED") << "\n";
+        log_info("[Wheel] Join state toggled to %s",
+                 app.join_open.load() ? "OPEN" : "CLOSED");
     }
 }
 
@@ -2284,20 +6104,29 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
 #ifndef __EMSCRIPTEN__
     if (twitchEnabled) {
         twitchRunning.store(false);
+        twitch_chat_wake(twitchWaker);
         if (twitchThread.joinable()) {
             twitchThread.join();
         }
+        irc_waker_close(twitchWaker);
+        net_cleanup();
+        log_channel_stats(app);
     }
+    journal_close();
 #endif
 
+    log_stop();
+
+    workers_stop();
+    label_cache_clear();
+    text_engine_close();
+    text_widget_release(g_status_text);
+    text_widget_release(g_hold_text);
+    text_widget_release(g_search_text);
+
     if (app.renderer) SDL_DestroyRenderer(app.renderer);
     if (app.window)   SDL_DestroyWindow(app.window);
-    if (app.status_font && app.status_font != app.font) {
-        TTF_CloseFont(app.status_font);
-    }
-    if (app.font) {
-        TTF_CloseFont(app.font);
-    }
+    assets_release(app);
 
 
     TTF_Quit();
@@ -2305,3 +6134,4 @@ else if (e.type == SDL_EVENT_MOUSE_BUTTON_DOWN) {
     SDL_Quit();
     return 0;
 }
+#endif // SHOEPEWHEEL_NO_MAIN